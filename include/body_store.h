@@ -0,0 +1,228 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef BODY_STORE_H
+#define BODY_STORE_H
+
+#include "./vector.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Contiguous structure-of-arrays storage for the dynamic state of the bodies
+ * registered with a Universe. Registered Objects are thin handles onto a slot
+ * of this store, so the stepping code can walk plain arrays instead of chasing
+ * Object pointers through virtual accessors.
+ *
+ * Every component of the positions and velocities has its own array, DIM of
+ * each. The dimension is a template parameter so the loops over the axes are
+ * unrolled at compile time: BodyStore is the planar store of the Universe and
+ * BodyStore3 the spatial one.
+ */
+template <uint32_t DIM> class BasicBodyStore {
+public:
+    // Default constructor
+    BasicBodyStore() = default;
+    // Default destructor
+    ~BasicBodyStore() = default;
+
+    /**
+     * Copies the bodies of other. The copy gets a version of its own, so caches
+     * keyed on the version of one store never take the other for it
+     * @param other - store to copy
+     */
+    BasicBodyStore(const BasicBodyStore& other);
+
+    /**
+     * Takes the bodies of other, along with its version. other is left with a
+     * new one
+     * @param other - store to move from
+     */
+    BasicBodyStore(BasicBodyStore&& other) noexcept;
+
+    /**
+     * Replaces the bodies with those of other under a new version
+     * @param other - store to copy
+     */
+    BasicBodyStore& operator=(const BasicBodyStore& other);
+
+    /**
+     * Takes the bodies of other, along with its version. other is left with a
+     * new one
+     * @param other - store to move from
+     */
+    BasicBodyStore& operator=(BasicBodyStore&& other) noexcept;
+
+    /**
+     * Returns the number of bodies in the store
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * Appends a body to the end of every array
+     * @param mass - mass of the body
+     * @param pos - position vector
+     * @param vel - velocity vector
+     * @param particle - true for a test particle, which feels gravity but exerts none
+     * @return slot index of the new body
+     * @throws std::logic_error if the first body, the sun, is a test particle
+     */
+    std::size_t add(
+        double mass, const Vector<DIM>& pos, const Vector<DIM>& vel, bool particle = false);
+
+    /**
+     * Removes the body in the given slot. Later bodies move down one slot.
+     * @param slot - body to remove
+     */
+    void remove(std::size_t slot);
+
+    /**
+     * Removes every body while keeping the allocated capacity
+     */
+    void clear() noexcept;
+
+    /**
+     * Reserves room for count bodies in every array
+     * @param count - number of bodies to make room for
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * Returns the mass of the body in the given slot
+     */
+    [[nodiscard]] double getMass(std::size_t slot) const noexcept;
+
+    /**
+     * Sets the mass of the body in the given slot
+     */
+    void setMass(std::size_t slot, double mass) noexcept;
+
+    /**
+     * Returns the physical radius of the body in the given slot, 0 for a
+     * point mass
+     */
+    [[nodiscard]] double getRadius(std::size_t slot) const noexcept;
+
+    /**
+     * Sets the physical radius of the body in the given slot, in meters
+     */
+    void setRadius(std::size_t slot, double radius) noexcept;
+
+    /**
+     * Returns the position of the body in the given slot
+     */
+    [[nodiscard]] Vector<DIM> getPosition(std::size_t slot) const noexcept;
+
+    /**
+     * Returns the velocity of the body in the given slot
+     */
+    [[nodiscard]] Vector<DIM> getVelocity(std::size_t slot) const noexcept;
+
+    /**
+     * Sets the position of the body in the given slot
+     */
+    void setPosition(std::size_t slot, const Vector<DIM>& pos) noexcept;
+
+    /**
+     * Sets the velocity of the body in the given slot
+     */
+    void setVelocity(std::size_t slot, const Vector<DIM>& vel) noexcept;
+
+    /**
+     * Returns true if the body in the given slot is a test particle
+     */
+    [[nodiscard]] bool isParticle(std::size_t slot) const noexcept;
+
+    /**
+     * Makes the body in the given slot a test particle, which is pulled by the
+     * other bodies but exerts no pull itself, or a regular body again
+     * @param slot - body to change
+     * @param particle - true for a test particle
+     * @throws std::logic_error if slot is 0, the sun pulls on every body
+     */
+    void setParticle(std::size_t slot, bool particle);
+
+    /**
+     * Makes every body from slot first on a test particle if it is lighter
+     * than threshold and a regular body otherwise, in a single pass
+     * @param threshold - mass in kilograms below which bodies become particles
+     * @param first - first slot to reclassify, earlier slots are left alone
+     */
+    void setParticlesBelow(double threshold, std::size_t first);
+
+    /**
+     * Returns the slots of the bodies that are not test particles, in slot
+     * order. Force loops run over these as sources, which makes the cost
+     * O(sources * N) instead of O(N^2).
+     */
+    [[nodiscard]] const std::vector<std::uint32_t>& getSources() const noexcept;
+
+    /**
+     * Raw access to the component arrays for the hot loops. The pointers stay
+     * valid until the next add() or reserve().
+     * @param axis - component, 0 to DIM - 1
+     */
+    [[nodiscard]] double* pos(uint32_t axis) noexcept;
+    [[nodiscard]] const double* pos(uint32_t axis) const noexcept;
+    [[nodiscard]] double* vel(uint32_t axis) noexcept;
+    [[nodiscard]] const double* vel(uint32_t axis) const noexcept;
+
+    // Named shorthands for pos() and vel()
+    [[nodiscard]] double* x() noexcept;
+    [[nodiscard]] const double* x() const noexcept;
+    [[nodiscard]] double* y() noexcept;
+    [[nodiscard]] const double* y() const noexcept;
+    [[nodiscard]] double* z() noexcept
+        requires(DIM >= 3);
+    [[nodiscard]] const double* z() const noexcept
+        requires(DIM >= 3);
+    [[nodiscard]] double* vx() noexcept;
+    [[nodiscard]] const double* vx() const noexcept;
+    [[nodiscard]] double* vy() noexcept;
+    [[nodiscard]] const double* vy() const noexcept;
+    [[nodiscard]] double* vz() noexcept
+        requires(DIM >= 3);
+    [[nodiscard]] const double* vz() const noexcept
+        requires(DIM >= 3);
+    [[nodiscard]] const double* mass() const noexcept;
+    // Mass every body pulls with: its mass, or 0 for a test particle
+    [[nodiscard]] const double* activeMass() const noexcept;
+    [[nodiscard]] const double* radius() const noexcept;
+
+    /**
+     * Returns a number that changes whenever the state changes through add(),
+     * remove(), clear(), setMass(), setRadius(), setPosition(), setVelocity(),
+     * setParticle() or setParticlesBelow(), and on every copy or assignment. No two
+     * stores ever hand out the same version, so it identifies the state for
+     * caches of derived values.
+     */
+    [[nodiscard]] std::uint64_t getVersion() const noexcept;
+
+    /**
+     * Gives the store a new version. Callers writing through the raw arrays
+     * must call this afterwards, unless they keep their caches up to date
+     * themselves.
+     */
+    void touch() noexcept;
+
+private:
+    /**
+     * Returns a version never handed out before
+     */
+    static std::uint64_t nextVersion() noexcept;
+
+    std::array<std::vector<double>, DIM> positions; // One array per axis, in meters
+    std::array<std::vector<double>, DIM> velocities; // One array per axis, in meters/second
+    std::vector<double> masses; // mass of every body, in kilograms
+    std::vector<double> active; // mass every body pulls with, 0 for test particles
+    std::vector<double> radii; // physical radius of every body, in meters
+    std::vector<std::uint8_t> particles; // 1 for test particles, 0 for regular bodies
+    std::vector<std::uint32_t> sources; // Slots of the regular bodies
+    std::uint64_t version = nextVersion(); // Identifies the current state
+};
+
+typedef BasicBodyStore<2> BodyStore;
+typedef BasicBodyStore<3> BodyStore3;
+
+#endif // BODY_STORE_H
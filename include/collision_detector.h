@@ -0,0 +1,87 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef COLLISION_DETECTOR_H
+#define COLLISION_DETECTOR_H
+
+#include "./body_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A pair of bodies found closer than the sum of their radii plus the
+ * encounter distance.
+ */
+struct Encounter {
+    std::uint32_t first = 0; // Lower slot of the pair
+    std::uint32_t second = 0; // Higher slot of the pair
+    double distance = 0.0; // Distance between the centers, in meters
+    bool impact = false; // True if the bodies touch or overlap
+};
+
+/**
+ * Finds touching and closely passing bodies among the current positions of a
+ * store with sweep and prune. Every body covers the interval of x within its
+ * radius plus half the encounter distance. The bodies are kept sorted by the
+ * start of their interval, and only pairs whose intervals overlap reach the
+ * exact distance test.
+ *
+ * The order is kept between calls and re-sorted by insertion, which is linear
+ * when the bodies moved past few of their neighbours since the last call. A
+ * full sort is only done for the first call, after the number of bodies
+ * changed, or when the insertion sort had too much to do. Bodies with very
+ * different radii need no tuning: each one only reaches as far as its own
+ * radius.
+ */
+template <uint32_t DIM> class BasicCollisionDetector {
+public:
+    // Moves per body above which the insertion sort gives way to a full sort
+    static constexpr std::size_t MAX_SHIFTS = 8;
+
+    /**
+     * Sets the gap between two surfaces under which a pass is reported as a
+     * close encounter. 0 reports impacts only.
+     * @param distance - gap in meters, not negative
+     */
+    void setEncounterDistance(double distance);
+
+    /**
+     * Returns the gap under which passes are reported
+     */
+    [[nodiscard]] double getEncounterDistance() const noexcept;
+
+    /**
+     * Finds every pair of bodies that touch, or pass within the encounter
+     * distance of each other, at their current positions. Bodies at the same
+     * position touch even with zero radii.
+     * @param bodies - state to examine
+     * @return pairs found, ordered by lower slot then higher slot. Valid until
+     * the next call.
+     */
+    const std::vector<Encounter>& detect(const BasicBodyStore<DIM>& bodies);
+
+    /**
+     * Returns the number of pairs that passed the sweep in the last call
+     */
+    [[nodiscard]] std::size_t getCandidateCount() const noexcept;
+
+private:
+    /**
+     * Brings order in line with the interval starts, by insertion if the
+     * bodies are still nearly sorted
+     */
+    void sort();
+
+    double encounterDistance = 0.0; // Reported gap between surfaces, in meters
+    std::size_t candidates = 0; // Pairs that passed the sweep in the last call
+    std::vector<std::uint32_t> order; // Slots sorted by interval start, kept between calls
+    std::vector<double> lower; // Start of the x interval of every slot
+    std::vector<double> upper; // End of the x interval of every slot
+    std::vector<Encounter> encounters; // Result of the last call
+};
+
+typedef BasicCollisionDetector<2> CollisionDetector;
+typedef BasicCollisionDetector<3> CollisionDetector3;
+
+#endif // COLLISION_DETECTOR_H
@@ -0,0 +1,151 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef ENSEMBLE_BATCH_H
+#define ENSEMBLE_BATCH_H
+
+#include "./body_store.h"
+#include "./vector.h"
+#include "solvers/simd_solver.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Many perturbed copies of one small system stepped together. A system of 9
+ * to 20 bodies is too small to vectorize over its bodies, so the batch
+ * vectorizes over the copies instead: every array holds body i of member k at
+ * i * stride + k, and one register covers the same body in 4 (AVX2) or 8
+ * (AVX-512) members. The member count is padded to a whole register with
+ * empty lanes.
+ *
+ * Every member follows the force law of DirectSolver in its deterministic
+ * mode, every row summed in slot order, and the kick-drift-kick leapfrog.
+ * All kernels use IEEE division and square root without fused multiply-adds,
+ * so member k has exactly the bits of a Universe with a LeapfrogIntegrator and
+ * a deterministic DirectSolver started from the same state: step() matches
+ * stepSimulation and advance() matches Universe::advance. The first body is
+ * the fixed sun, test particles pull on nobody.
+ */
+class EnsembleBatch {
+public:
+    static constexpr std::size_t LANES = 8; // Members per register of the widest kernel
+
+    /**
+     * Creates members copies of a system
+     * @param system - initial state of every member
+     * @param members - number of copies, must be positive
+     */
+    EnsembleBatch(const BodyStore& system, std::size_t members);
+
+    /**
+     * Returns the number of members
+     */
+    [[nodiscard]] std::size_t getMemberCount() const noexcept;
+
+    /**
+     * Returns the number of bodies of every member
+     */
+    [[nodiscard]] std::size_t getBodyCount() const noexcept;
+
+    /**
+     * Selects the kernel to use, clamped to what the CPU supports as in
+     * SimdSolver. Every level gives the same bits.
+     * @param level - requested instruction set
+     */
+    void setLevel(SimdLevel level) noexcept;
+
+    /**
+     * Returns the instruction set of the kernel in use
+     */
+    [[nodiscard]] SimdLevel getLevel() const noexcept;
+
+    /**
+     * Moves one body of one member, for perturbing the initial conditions
+     * @param member - index of the member
+     * @param slot - slot of the body in the system
+     * @param pos - new position
+     */
+    void setPosition(std::size_t member, std::size_t slot, const Vector2& pos);
+
+    /**
+     * Changes the velocity of one body of one member
+     * @param member - index of the member
+     * @param slot - slot of the body in the system
+     * @param vel - new velocity
+     */
+    void setVelocity(std::size_t member, std::size_t slot, const Vector2& vel);
+
+    /**
+     * Returns the position of one body of one member
+     */
+    [[nodiscard]] Vector2 getPosition(std::size_t member, std::size_t slot) const;
+
+    /**
+     * Returns the velocity of one body of one member
+     */
+    [[nodiscard]] Vector2 getVelocity(std::size_t member, std::size_t slot) const;
+
+    /**
+     * Returns the current state of one member as a store of its own
+     * @param member - index of the member
+     */
+    [[nodiscard]] BodyStore getMember(std::size_t member) const;
+
+    /**
+     * Advances every member by one kick-drift-kick step
+     * @param dt - time step in seconds
+     */
+    void step(double dt);
+
+    /**
+     * Advances every member by steps steps, merging the closing half kick of
+     * every step with the opening half kick of the next
+     * @param dt - time step in seconds
+     * @param steps - number of steps
+     */
+    void advance(double dt, std::size_t steps);
+
+    /**
+     * Returns the simulated seconds so far
+     */
+    [[nodiscard]] double getTime() const noexcept;
+
+private:
+    /**
+     * Throws if member or slot is out of range and returns the array index
+     */
+    [[nodiscard]] std::size_t index(std::size_t member, std::size_t slot) const;
+
+    /**
+     * Makes ax and ay hold the accelerations at the current positions
+     */
+    void evaluate();
+
+    /**
+     * Adds dt times the accelerations to the velocities
+     */
+    void kick(double dt);
+
+    /**
+     * Adds dt times the velocities to the positions
+     */
+    void drift(double dt);
+
+    BodyStore system; // Masses, radii and particle flags shared by every member
+    std::vector<std::uint32_t> sources; // Slots of the bodies that pull, as in the system
+    std::size_t members; // Number of members
+    std::size_t bodies; // Bodies of every member
+    std::size_t stride; // Lanes per body, members rounded up to LANES
+    SimdLevel level; // Instruction set of the kernel in use
+    bool fresh = false; // True if ax and ay belong to the current positions
+    double time = 0.0; // Simulated seconds so far
+    std::vector<double> x; // x positions, body major
+    std::vector<double> y; // y positions
+    std::vector<double> vx; // x velocities
+    std::vector<double> vy; // y velocities
+    std::vector<double> ax; // x accelerations at the current positions
+    std::vector<double> ay; // y accelerations at the current positions
+};
+
+#endif // ENSEMBLE_BATCH_H
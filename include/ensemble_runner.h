@@ -0,0 +1,73 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef ENSEMBLE_RUNNER_H
+#define ENSEMBLE_RUNNER_H
+
+#include "./body_store.h"
+#include "./thread_pool.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Universe;
+
+/**
+ * The outcome of one member of an ensemble
+ */
+struct EnsembleMember {
+    std::size_t index = 0; // Position of the member in the ensemble
+    double time = 0.0; // Simulated seconds at the end of the run
+    BodyStore state; // Bodies at the end of the run, in registration order
+    std::string error; // What the member threw, empty if it ran to the end
+};
+
+/**
+ * Runs many independent simulations in one process, for parameter sweeps and
+ * ensembles of perturbed initial conditions. Every member gets a Universe of
+ * its own, built, stepped and destroyed by one task on the pool, so at most as
+ * many Universes as threads are alive at a time. The members run serially
+ * inside, the parallelism is across members.
+ */
+class EnsembleRunner {
+public:
+    // Fills the Universe of member index, called before its run
+    typedef std::function<void(Universe& universe, std::size_t index)> Setup;
+    // Reads whatever else is needed from the Universe of member index after its run
+    typedef std::function<void(Universe& universe, std::size_t index)> Collect;
+
+    /**
+     * Creates a runner and starts its workers
+     * @param threads - number of threads including the caller, must be positive
+     */
+    explicit EnsembleRunner(std::size_t threads);
+
+    /**
+     * Returns the number of threads the members are spread over
+     */
+    [[nodiscard]] std::size_t getThreadCount() const noexcept;
+
+    /**
+     * Builds members Universes with setup and advances each by steps steps of
+     * dt. setup and collect are called concurrently for different members and
+     * must only touch the Universe they are given, or state of their own
+     * member. A member that throws is reported with its message and does not
+     * stop the others.
+     * @param members - number of members
+     * @param setup - fills the Universe of a member, through the ObjectFactory
+     * and Parser overloads taking a Universe
+     * @param dt - time step in seconds
+     * @param steps - number of steps of every member
+     * @param collect - called with every Universe after its run, may be empty
+     * @return the outcome of every member, ordered by index
+     */
+    std::vector<EnsembleMember> run(std::size_t members, const Setup& setup, double dt,
+        std::size_t steps, const Collect& collect = {});
+
+private:
+    std::unique_ptr<ThreadPool> pool; // Workers running the members, null when serial
+};
+
+#endif // ENSEMBLE_RUNNER_H
@@ -0,0 +1,124 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef DORMAND_PRINCE_H
+#define DORMAND_PRINCE_H
+
+#include "./integrator.h"
+#include "body_store.h"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * Embedded Runge-Kutta 5(4) pair of Dormand and Prince (J. Comp. Appl. Math.
+ * 6, 1980) with automatic step size control.
+ *
+ * A step takes seven stages, the last of which is evaluated at the new state
+ * and opens the next step (first same as last), so an accepted step costs six
+ * force evaluations. The difference between the fifth and the embedded fourth
+ * order solutions estimates the local error. It is compared body by body
+ * against tolerance times the size of the position and of the velocity, and
+ * the worst body decides whether the step is accepted and how long the next
+ * one is.
+ *
+ * The stages also give a fourth order continuous extension (Hairer, Norsett &
+ * Wanner, Solving ODEs I, II.6), used to report the state at any time inside
+ * an accepted step without further force evaluations.
+ */
+class DormandPrinceIntegrator : public Integrator {
+public:
+    // Receives the interpolated state at a requested time
+    typedef std::function<void(double time, const BodyStore& state)> DenseOutput;
+
+    static constexpr std::size_t STAGES = 7; // Stages of a step, the last opens the next step
+
+    /**
+     * Creates an integrator with the given relative tolerance
+     * @param tolerance - allowed local error per step relative to the size of
+     * the positions and velocities, must be positive
+     */
+    explicit DormandPrinceIntegrator(double tolerance = 1e-10);
+
+    /**
+     * Returns the relative tolerance
+     */
+    [[nodiscard]] double getTolerance() const noexcept;
+
+    /**
+     * Advances every body but the first by exactly dt, in as many steps as the
+     * tolerance requires
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time to cover in seconds, may be negative
+     */
+    void step(BodyStore& bodies, ForceSolver& solver, double dt) override;
+
+    /**
+     * Advances every body but the first by exactly dt and reports the state at
+     * the requested times along the way
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time to cover in seconds, may be negative
+     * @param times - offsets from the start, ordered from 0 towards dt
+     * @param output - called with every offset of times and the state there
+     */
+    void advanceDense(BodyStore& bodies, ForceSolver& solver, double dt,
+        const std::vector<double>& times, const DenseOutput& output);
+
+    /**
+     * Returns the length of the next step in seconds, 0 before the first step
+     */
+    [[nodiscard]] double getStepSize() const noexcept;
+
+    /**
+     * Returns the number of accepted steps so far
+     */
+    [[nodiscard]] std::size_t getAcceptedSteps() const noexcept;
+
+    /**
+     * Returns the number of rejected steps so far
+     */
+    [[nodiscard]] std::size_t getRejectedSteps() const noexcept;
+
+private:
+    /**
+     * Derivatives of the state at one stage
+     */
+    struct Stage {
+        std::vector<double> vx; // x velocity, the derivative of the x position
+        std::vector<double> vy; // y velocity, the derivative of the y position
+        std::vector<double> ax; // x acceleration, the derivative of the x velocity
+        std::vector<double> ay; // y acceleration, the derivative of the y velocity
+    };
+
+    /**
+     * Runs stages 2 to 7 of a step from the saved start state. The positions
+     * of bodies end up at the new state.
+     * @param bodies - state whose positions are overwritten by every stage
+     * @param solver - strategy computing the accelerations
+     * @param h - step length in seconds, may be negative
+     * @return largest error of any body relative to the tolerance
+     */
+    double attempt(BodyStore& bodies, ForceSolver& solver, double h);
+
+    /**
+     * Fills dense with the state a fraction theta into the accepted step h
+     */
+    void interpolate(const BodyStore& bodies, double h, double theta);
+
+    double tolerance; // Allowed local error relative to the state
+    double stepSize = 0.0; // Length of the next step in seconds, 0 if not known yet
+    std::size_t accepted = 0; // Accepted steps so far
+    std::size_t rejected = 0; // Rejected steps so far
+
+    std::vector<double> startX; // x position at the start of the step
+    std::vector<double> startY; // y position at the start of the step
+    std::vector<double> startVx; // x velocity at the start of the step
+    std::vector<double> startVy; // y velocity at the start of the step
+    std::array<Stage, STAGES> stages; // Derivatives at every stage of the step
+    BodyStore dense; // State handed to the dense output
+};
+
+#endif // DORMAND_PRINCE_H
@@ -0,0 +1,45 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef EULER_H
+#define EULER_H
+
+#include "./integrator.h"
+
+/**
+ * First order explicit Euler: positions advance with the old velocities and
+ * velocities with the old accelerations. It is not symplectic and the orbits
+ * spiral outwards, but it is the historical behavior and the default of the
+ * Universe.
+ */
+template <uint32_t DIM> class BasicEulerIntegrator : public BasicIntegrator<DIM> {
+public:
+    /**
+     * Advances every body but the first by one Euler step
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds
+     */
+    void step(BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt) override;
+
+    /**
+     * Runs steps Euler steps in one loop, touching the store once at the end
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds
+     * @param steps - number of steps
+     */
+    void advance(BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt,
+        std::size_t steps) override;
+
+private:
+    /**
+     * Moves the positions with the velocities and the velocities with the
+     * current accelerations
+     */
+    void update(BasicBodyStore<DIM>& bodies, double dt);
+};
+
+typedef BasicEulerIntegrator<2> EulerIntegrator;
+typedef BasicEulerIntegrator<3> EulerIntegrator3;
+
+#endif // EULER_H
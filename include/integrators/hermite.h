@@ -0,0 +1,107 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef HERMITE_H
+#define HERMITE_H
+
+#include "./integrator.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Fourth order Hermite predictor-corrector with individual block time steps
+ * (Makino & Aarseth, PASJ 44, 1992).
+ *
+ * Every body gets its own step dt / 2^k, where dt is the step passed to
+ * step(). At each block time only the bodies whose step is due are active:
+ * all bodies are predicted to that time from their acceleration and jerk, the
+ * active ones get fresh accelerations and jerks from the predicted state and
+ * are corrected with the interpolated snap and crackle. Their next step comes
+ * from Aarseth's criterion, halved as needed, and doubled only when the new
+ * time is a multiple of the doubled step so the blocks stay aligned. Every
+ * body is synchronized again at the end of step().
+ *
+ * The jerk needs the relative velocities, which the ForceSolver interface does
+ * not provide, so this integrator sums accelerations and jerks directly and
+ * ignores the solver. A block costs O(active * sources), test particles pull
+ * on nobody.
+ */
+class HermiteIntegrator : public Integrator {
+public:
+    static constexpr std::uint32_t MAX_LEVEL = 40; // Smallest step is dt / 2^MAX_LEVEL
+
+    /**
+     * Creates an integrator with the given accuracy parameter
+     * @param eta - Aarseth step criterion coefficient, between 0 and 1 exclusive
+     */
+    explicit HermiteIntegrator(double eta = 0.02);
+
+    /**
+     * Returns the accuracy parameter
+     */
+    [[nodiscard]] double getEta() const noexcept;
+
+    /**
+     * Advances every body but the first by dt in block steps
+     * @param bodies - state to advance in place
+     * @param solver - ignored, the accelerations are summed directly
+     * @param dt - time step in seconds, every body is synchronized after it
+     */
+    void step(BodyStore& bodies, ForceSolver& solver, double dt) override;
+
+    /**
+     * Returns the individual time step of a body in seconds, as chosen at the
+     * end of the last step()
+     * @param slot - body to query
+     */
+    [[nodiscard]] double getTimeStep(std::size_t slot) const noexcept;
+
+    /**
+     * Returns the total number of single body acceleration and jerk
+     * evaluations, the unit of work of this scheme
+     */
+    [[nodiscard]] std::uint64_t getBodyEvaluations() const noexcept;
+
+    /**
+     * Returns the number of block times processed so far
+     */
+    [[nodiscard]] std::uint64_t getBlockCount() const noexcept;
+
+private:
+    /**
+     * Computes the acceleration and jerk of every body in active from the
+     * predicted state of all bodies
+     */
+    void evaluate(const BodyStore& bodies);
+
+    /**
+     * Computes the state of every body at the start of a step and picks the
+     * initial steps of bodies seen for the first time
+     * @param bodies - state at the start of the step
+     * @param dt - length of the step in seconds
+     */
+    void start(const BodyStore& bodies, double dt);
+
+    double eta; // Aarseth step criterion coefficient
+    std::uint64_t cachedVersion = 0; // Store version the accelerations and jerks belong to
+    std::uint64_t bodyEvaluations = 0; // Single body evaluations so far
+    std::uint64_t blocks = 0; // Block times processed so far
+
+    std::vector<std::uint32_t> level; // Step of every body is dt / 2^level
+    std::vector<std::uint64_t> time; // Time of every body in ticks of dt / 2^MAX_LEVEL
+    std::vector<double> stepSeconds; // Step of every body in seconds, 0 if not chosen yet
+    // acc of the base class holds the accelerations at the body's time
+    std::vector<double> jerkX; // x jerk at the body's time
+    std::vector<double> jerkY; // y jerk at the body's time
+    std::vector<double> predX; // x position predicted to the current block time
+    std::vector<double> predY; // y position predicted to the current block time
+    std::vector<double> predVx; // x velocity predicted to the current block time
+    std::vector<double> predVy; // y velocity predicted to the current block time
+    std::vector<double> newAx; // x acceleration of the active bodies, indexed like active
+    std::vector<double> newAy; // y acceleration of the active bodies, indexed like active
+    std::vector<double> newJx; // x jerk of the active bodies, indexed like active
+    std::vector<double> newJy; // y jerk of the active bodies, indexed like active
+    std::vector<std::uint32_t> active; // Bodies due at the current block time
+};
+
+#endif // HERMITE_H
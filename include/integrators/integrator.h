@@ -0,0 +1,193 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+#include "body_store.h"
+#include "solvers/force_solver.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Abstract base class of the time stepping schemes. The Universe owns exactly
+ * one integrator and calls it from stepSimulation. The first body is the fixed
+ * sun and is never moved.
+ *
+ * The base class caches the accelerations of the last evaluation together with
+ * the solver, its settings generation and the BodyStore version they belong to,
+ * so a scheme that needs the forces at the same positions twice (the closing
+ * kick of a leapfrog step and the opening kick of the next one) pays for them
+ * once, and a changed solver setting is seen by the next step.
+ *
+ * With compensation enabled, every position and velocity keeps the low order
+ * bits its last update could not represent and adds them back with the next
+ * one (Neumaier's variant of Kahan summation), so round-off no longer grows
+ * with the number of steps. The carried bits are dropped whenever anyone else
+ * changes the store. The explicit Euler and the leapfrog family honour it.
+ *
+ * Integrator steps the planar BodyStore and Integrator3 the spatial
+ * BodyStore3. Only the explicit Euler and the leapfrog family come in both
+ * dimensions, the other schemes are planar.
+ */
+template <uint32_t DIM> class BasicIntegrator {
+public:
+    // Default constructor
+    BasicIntegrator() = default;
+    // Default destructor
+    virtual ~BasicIntegrator() = default;
+    // Copy and assignment not allowed
+    BasicIntegrator(const BasicIntegrator&) = delete;
+    BasicIntegrator& operator=(const BasicIntegrator&) = delete;
+
+    /**
+     * Advances every body but the first by dt
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds
+     */
+    virtual void step(BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt) = 0;
+
+    /**
+     * Advances every body but the first by steps steps of dt. Equivalent to
+     * calling step() steps times, schemes that can run the batch in a tighter
+     * loop override it.
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds
+     * @param steps - number of steps
+     */
+    virtual void advance(BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt,
+        std::size_t steps);
+
+    /**
+     * Lets the integrator split its updates over the workers of a pool
+     * @param pool - pool owned by the caller, or null for serial updates
+     */
+    void setThreadPool(ThreadPool* pool) noexcept;
+
+    /**
+     * Returns the pool set by setThreadPool, or null
+     */
+    [[nodiscard]] ThreadPool* getThreadPool() const noexcept;
+
+    /**
+     * Returns the number of force evaluations done so far, cache hits excluded
+     */
+    [[nodiscard]] std::size_t getForceEvaluations() const noexcept;
+
+    /**
+     * Enables or disables compensated summation of the position and velocity
+     * updates. Universe::sumForce compensates its sums as well when enabled.
+     * @param enabled - true to carry the bits lost by every update
+     */
+    void setCompensation(bool enabled) noexcept;
+
+    /**
+     * Returns true if the updates are compensated
+     */
+    [[nodiscard]] bool getCompensation() const noexcept;
+
+    /**
+     * Adds term to sum, keeping the bits the addition loses in carry and
+     * adding them back first the next time. sum + carry is the exact total.
+     * @param sum - running sum, updated in place
+     * @param carry - bits lost so far, updated in place
+     * @param term - value to add
+     */
+    static void compensatedAdd(double& sum, double& carry, double term) noexcept
+    {
+        const double y = term + carry;
+        const double t = sum + y;
+        carry = std::abs(sum) >= std::abs(y) ? (sum - t) + y : (y - t) + sum;
+        sum = t;
+    }
+
+protected:
+    /**
+     * Makes acc hold the accelerations at the current positions,
+     * evaluating the solver only if the cache is stale
+     * @param bodies - current state of the bodies
+     * @param solver - strategy computing the accelerations
+     */
+    void updateAccelerations(const BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver);
+
+    /**
+     * Evaluates the accelerations at the current positions into acc,
+     * whatever the cache says. Batched loops use it so they can leave
+     * the store untouched until the end of the batch.
+     * @param bodies - current state of the bodies
+     * @param solver - strategy computing the accelerations
+     */
+    void evaluateAccelerations(const BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver);
+
+    /**
+     * Marks acc as the accelerations of the current state, after a
+     * batched loop that ended with an evaluation has touched the store
+     * @param bodies - current state of the bodies
+     * @param solver - strategy the accelerations were computed by
+     */
+    void keepAccelerations(
+        const BasicBodyStore<DIM>& bodies, const BasicForceSolver<DIM>& solver) noexcept;
+
+    /**
+     * Runs task over every body but the first, split over the thread pool if
+     * there is one. Without a pool the task is called inline, no std::function
+     * is built.
+     * @param count - number of bodies
+     * @param task - called with [begin, end) ranges of bodies and the worker
+     */
+    template <typename Task> void forEachBody(std::size_t count, const Task& task)
+    {
+        if (!pool) {
+            // The sun in slot 0 never moves
+            task(std::size_t { 1 }, count, std::size_t { 0 });
+            return;
+        }
+        pool->parallelFor(count, [&task](std::size_t begin, std::size_t end, std::size_t worker) {
+            task(std::max<std::size_t>(begin, 1), end, worker);
+        });
+    }
+
+    /**
+     * Drops the carried bits if the store changed size or was changed by
+     * anyone else since the last compensated update. Call before updating.
+     * @param bodies - state about to be updated
+     */
+    void prepareCompensation(const BasicBodyStore<DIM>& bodies);
+
+    /**
+     * Ties the carried bits to the current version of the store. Call after
+     * the last touch of a step.
+     * @param bodies - state just updated
+     */
+    void keepCompensation(const BasicBodyStore<DIM>& bodies) noexcept;
+
+    std::array<std::vector<double>, DIM> acc; // Accelerations at the cached positions, per axis
+    std::array<std::vector<double>, DIM> posCarry; // Bits lost by the position updates, per axis
+    std::array<std::vector<double>, DIM> velCarry; // Bits lost by the velocity updates, per axis
+
+private:
+    /**
+     * Sizes acc for count bodies and lets the solver fill it
+     */
+    void evaluate(const BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver);
+
+    ThreadPool* pool = nullptr; // Workers to split the updates over, not owned
+    const BasicForceSolver<DIM>* cachedSolver = nullptr; // Solver acc was computed by
+    std::uint64_t cachedGeneration = 0; // Settings generation of that solver
+    std::uint64_t cachedVersion = 0; // Store version acc belongs to, 0 if none
+    std::size_t evaluations = 0; // Number of solver calls
+    bool compensation = false; // Carry the bits lost by every update
+    std::uint64_t carryVersion = 0; // Store version the carried bits belong to, 0 if none
+};
+
+typedef BasicIntegrator<2> Integrator;
+typedef BasicIntegrator<3> Integrator3;
+
+#endif // INTEGRATOR_H
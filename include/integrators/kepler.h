@@ -0,0 +1,36 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef KEPLER_H
+#define KEPLER_H
+
+#include <cstddef>
+
+/**
+ * Moves bodies [begin, end) along their exact two body orbits around a fixed
+ * point mass, in universal variables, so bound, parabolic and hyperbolic
+ * orbits go through the same code.
+ *
+ * Bodies are handled in blocks of KEPLER_LANES that run every phase in
+ * lockstep: the orbital constants, the Laguerre-Conway iterations on the
+ * universal Kepler equation and the f and g update are each a straight loop
+ * over the lanes of the block, and the block iterates until its slowest lane
+ * has converged. The arithmetic of those loops vectorizes, the trigonometric
+ * Stumpff functions are evaluated lane by lane.
+ *
+ * @param mu - gravitational parameter G * M of the central mass
+ * @param centerX - x position of the central mass
+ * @param centerY - y position of the central mass
+ * @param dt - time to advance in seconds, may be negative
+ * @param begin - first body to move
+ * @param end - one past the last body to move
+ * @param x - x positions, updated in place
+ * @param y - y positions, updated in place
+ * @param vx - x velocities, updated in place
+ * @param vy - y velocities, updated in place
+ */
+void keplerDrift(double mu, double centerX, double centerY, double dt, std::size_t begin,
+    std::size_t end, double* x, double* y, double* vx, double* vy);
+
+constexpr std::size_t KEPLER_LANES = 8; // Bodies solved in lockstep by keplerDrift
+
+#endif // KEPLER_H
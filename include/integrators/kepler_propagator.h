@@ -0,0 +1,80 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef KEPLER_PROPAGATOR_H
+#define KEPLER_PROPAGATOR_H
+
+#include "body_store.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Analytic propagator for bodies on unperturbed two body orbits around a fixed
+ * central mass. The state of every body is recorded once at an epoch, and
+ * propagate() jumps all of them to any later or earlier time with a single
+ * keplerDrift from the epoch state, so the cost does not depend on how far
+ * the jump goes and no error builds up from step to step.
+ */
+class KeplerPropagator {
+public:
+    /**
+     * Drops every body and sets the central mass and the epoch of the bodies
+     * added from now on
+     * @param mu - gravitational parameter G * M of the central mass
+     * @param center - position of the central mass
+     * @param epoch - time the added states belong to, in seconds
+     */
+    void reset(double mu, const Vector2& center, double epoch);
+
+    /**
+     * Adds a body on its orbit through the given state at the epoch
+     * @param slot - slot the body's state is written to by propagate()
+     * @param pos - position at the epoch
+     * @param vel - velocity at the epoch
+     */
+    void add(std::size_t slot, const Vector2& pos, const Vector2& vel);
+
+    /**
+     * Returns the number of bodies being propagated
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * Returns the slots of the bodies in the order they were added
+     */
+    [[nodiscard]] const std::vector<std::uint32_t>& getSlots() const noexcept;
+
+    /**
+     * Returns the time the recorded states belong to
+     */
+    [[nodiscard]] double getEpoch() const noexcept;
+
+    /**
+     * Writes the state of every body at the given time into its slot of
+     * bodies. The store is not touched, the caller does that once it is done.
+     * @param time - time to jump to, in seconds
+     * @param bodies - store receiving the states
+     * @param pool - pool to split the bodies over, or null
+     */
+    void propagate(double time, BodyStore& bodies, ThreadPool* pool = nullptr);
+
+private:
+    double mu = 0.0; // Gravitational parameter of the central mass
+    double centerX = 0.0; // Position of the central mass
+    double centerY = 0.0;
+    double epoch = 0.0; // Time of the recorded states
+    std::vector<std::uint32_t> slots; // Store slot of every body
+    std::vector<double> epochX; // Recorded states, one entry per body
+    std::vector<double> epochY;
+    std::vector<double> epochVX;
+    std::vector<double> epochVY;
+    std::vector<double> x; // Scratch copies drifted by propagate()
+    std::vector<double> y;
+    std::vector<double> vx;
+    std::vector<double> vy;
+};
+
+#endif // KEPLER_PROPAGATOR_H
@@ -0,0 +1,67 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef LEAPFROG_H
+#define LEAPFROG_H
+
+#include "./integrator.h"
+
+#include <vector>
+
+/**
+ * Second order kick-drift-kick leapfrog, also known as velocity Verlet. Half
+ * a kick with the accelerations at the start, a full drift, half a kick with
+ * the accelerations at the end. It is symplectic and time reversible, so the
+ * energy error stays bounded instead of drifting. The closing accelerations
+ * are cached and open the next step, one force evaluation per step.
+ * Compositions such as YoshidaIntegrator replace the single sub-step of
+ * weights with their own.
+ */
+template <uint32_t DIM> class BasicLeapfrogIntegrator : public BasicIntegrator<DIM> {
+public:
+    /**
+     * Advances every body but the first by one kick-drift-kick step
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds
+     */
+    void step(BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt) override;
+
+    /**
+     * Runs steps steps in one loop. The closing half kick of every sub-step
+     * and the opening half kick of the next are merged into one kick, and the
+     * store is touched once at the end
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds
+     * @param steps - number of steps
+     */
+    void advance(BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt,
+        std::size_t steps) override;
+
+protected:
+    /**
+     * One kick-drift-kick step of length dt
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds, may be negative
+     */
+    void kickDriftKick(BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt);
+
+    std::vector<double> weights { 1.0 }; // Length of every sub-step as a fraction of dt
+
+private:
+    /**
+     * Adds dt times the cached accelerations to the velocities
+     */
+    void kick(BasicBodyStore<DIM>& bodies, double dt);
+
+    /**
+     * Adds dt times the velocities to the positions, without touching the store
+     */
+    void drift(BasicBodyStore<DIM>& bodies, double dt);
+};
+
+typedef BasicLeapfrogIntegrator<2> LeapfrogIntegrator;
+typedef BasicLeapfrogIntegrator<3> LeapfrogIntegrator3;
+
+#endif // LEAPFROG_H
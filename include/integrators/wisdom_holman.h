@@ -0,0 +1,54 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef WISDOM_HOLMAN_H
+#define WISDOM_HOLMAN_H
+
+#include "./integrator.h"
+
+#include <vector>
+
+/**
+ * Wisdom-Holman symplectic map (Astron. J. 102, 1991) for sun dominated
+ * systems.
+ *
+ * Since the sun in slot 0 never moves, the motion of every other body splits
+ * exactly into a Kepler orbit around the sun plus the pull of the other
+ * bodies. A step is half a kick with the pull of the other bodies, an exact
+ * Kepler drift of dt (keplerDrift) and another half kick. The error scales
+ * with the ratio of the planetary pulls to the sun's, not with the orbital
+ * frequencies, so steps of days integrate the planets better than hour long
+ * leapfrog steps.
+ *
+ * The kicks take the full accelerations from the solver and subtract the
+ * sun's exact pull, so an approximate solver's error on the sun's pull shows
+ * up in the kicks. The closing kick of a step opens the next one, one force
+ * evaluation per step.
+ */
+class WisdomHolmanIntegrator : public Integrator {
+public:
+    /**
+     * Advances every body but the first by one kick-drift-kick step
+     * @param bodies - state to advance in place
+     * @param solver - strategy computing the accelerations
+     * @param dt - time step in seconds, may be negative
+     */
+    void step(BodyStore& bodies, ForceSolver& solver, double dt) override;
+
+private:
+    /**
+     * Adds dt times the pull of the bodies other than the sun to the velocities
+     * @param bodies - state whose velocities are updated
+     * @param solver - strategy computing the accelerations
+     * @param dt - length of the kick in seconds
+     */
+    void kick(BodyStore& bodies, ForceSolver& solver, double dt);
+
+    /**
+     * Moves every body but the first along its Kepler orbit around the sun
+     * @param bodies - state to advance in place
+     * @param dt - length of the drift in seconds
+     */
+    void drift(BodyStore& bodies, double dt);
+};
+
+#endif // WISDOM_HOLMAN_H
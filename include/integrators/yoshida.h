@@ -0,0 +1,39 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef YOSHIDA_H
+#define YOSHIDA_H
+
+#include "./leapfrog.h"
+
+#include <cstdint>
+
+/**
+ * Yoshida's symmetric compositions of the leapfrog (Phys. Lett. A 150, 1990).
+ * A step runs leapfrog sub-steps whose lengths are fixed fractions of dt,
+ * some of them negative, chosen so the error terms cancel up to the requested
+ * order. The 4th order scheme takes 3 sub-steps and the 6th order scheme 7
+ * (solution A). Neighbouring sub-steps share their force evaluation, so a step
+ * costs as many evaluations as it has sub-steps. The sub-steps are the weights
+ * the leapfrog steps and advances with.
+ */
+template <uint32_t DIM> class BasicYoshidaIntegrator : public BasicLeapfrogIntegrator<DIM> {
+public:
+    /**
+     * Creates an integrator of the given order
+     * @param order - 4 or 6
+     */
+    explicit BasicYoshidaIntegrator(std::uint32_t order = 4);
+
+    /**
+     * Returns the order of the composition
+     */
+    [[nodiscard]] std::uint32_t getOrder() const noexcept;
+
+private:
+    std::uint32_t order; // Order of the composition
+};
+
+typedef BasicYoshidaIntegrator<2> YoshidaIntegrator;
+typedef BasicYoshidaIntegrator<3> YoshidaIntegrator3;
+
+#endif // YOSHIDA_H
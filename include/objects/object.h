@@ -2,14 +2,20 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+#include "body_store.h"
 #include "vector.h"
+#include <cstddef>
 #include <string>
 
 class Visitor;
 class ObjectFactory;
+class Universe;
 
 /**
- *  Representation of objects suitable for use in the simulated universe
+ *  Representation of objects suitable for use in the simulated universe. Once
+ *  registered with a Universe an Object is a handle onto its slot in the
+ *  Universe's BodyStore and all dynamic state is read from and written to
+ *  that store. Unregistered Objects (e.g. snapshot clones) keep their own copy.
  */
 class Object {
 public:
@@ -76,6 +82,32 @@ public:
      */
     virtual void setVelocity(const Vector2& vel);
 
+    /**
+     * Returns true if this object is a test particle, which feels gravity but
+     * exerts none
+     * @return true if the object pulls on nobody
+     */
+    [[nodiscard]] virtual bool isTestParticle() const noexcept;
+
+    /**
+     * Marks this object as a test particle or as a regular body
+     * @param particle - true if the object should pull on nobody
+     * @throws std::logic_error if the object is the sun in slot 0 of a Universe
+     */
+    virtual void setTestParticle(bool particle);
+
+    /**
+     * Returns the physical radius used for collision detection
+     * @return radius in meters, 0 for a point mass
+     */
+    [[nodiscard]] virtual double getRadius() const noexcept;
+
+    /**
+     * Sets the physical radius used for collision detection
+     * @param radius - new radius in meters
+     */
+    virtual void setRadius(double radius);
+
     /**
      * Returns true if this object is member-wise equal to rhs
      * @param rhs - object to compare against
@@ -100,9 +132,30 @@ protected:
     Object(const std::string& name, double mass, const Vector2& pos, const Vector2& vel);
 
     std::string name; // Name of the object.
-    double mass; // Mass of the object in kilograms.
-    Vector2 position; // Position vector of the object in meters.
-    Vector2 velocity; // Velocity vector of the object in meters/second.
+    double mass; // Mass of the object in kilograms, used while unregistered.
+    Vector2 position; // Position vector of the object in meters, used while unregistered.
+    Vector2 velocity; // Velocity vector of the object in meters/second, used while unregistered.
+    bool testParticle = false; // Whether the object pulls on nobody, used while unregistered.
+    double radius = 0.0; // Physical radius in meters, used while unregistered.
+
+private:
+    friend class Universe; // Binds registered objects to its BodyStore
+
+    /**
+     * Turns this object into a handle onto the given slot of store
+     * @param store - store that owns the dynamic state from now on
+     * @param slot - index of this object within store
+     */
+    void bind(BodyStore* store, std::size_t slot) noexcept;
+
+    /**
+     * Copies the state of the bound slot into this object and lets go of the
+     * store, as when the Universe removes the object
+     */
+    void unbind() noexcept;
+
+    BodyStore* store = nullptr; // Store holding the dynamic state, null if unregistered
+    std::size_t slot = 0; // Index of this object within store
 };
 
 #endif // OBJECT_H
@@ -11,9 +11,12 @@
 class Object;
 class Planet;
 class Star;
+class Universe;
 
 /**
- *  A factory class used to make Object creation easier.
+ *  A factory class used to make Object creation easier. Every factory adds
+ *  the object to the Universe it is given, or to the process wide Universe
+ *  without one.
  */
 class ObjectFactory {
 public:
@@ -34,6 +37,18 @@ public:
     static Planet* makePlanet(
         const std::string& name, double mass, const Vector2& pos, const Vector2& vel);
 
+    /**
+     * Creates a planet in the given universe
+     * @param universe - universe the planet is added to
+     * @param name - name of the object
+     * @param mass - mass of the object - must be greater than 1e21 for planets
+     * @param pos - position vector
+     * @param vel - velocity vector
+     * @return planet object
+     */
+    static Planet* makePlanet(Universe& universe, const std::string& name, double mass,
+        const Vector2& pos, const Vector2& vel);
+
     /**
      * Creates a star at the center of the universe
      * @param name
@@ -42,6 +57,15 @@ public:
      */
     static Star* makeStar(const std::string& name, double mass);
 
+    /**
+     * Creates a star at the center of the given universe
+     * @param universe - universe the star is added to
+     * @param name
+     * @param mass - must be greater than 1e30 for stars
+     * @return star objects
+     */
+    static Star* makeStar(Universe& universe, const std::string& name, double mass);
+
     /**
      * Creates an asteroid with the provided parameters. Adds the object to
      * the singleton Universe
@@ -54,6 +78,18 @@ public:
     static Asteroid* makeAsteroid(
         const std::string& name, double mass, const Vector2& pos, const Vector2& vel);
 
+    /**
+     * Creates an asteroid in the given universe
+     * @param universe - universe the asteroid is added to
+     * @param name - name of the object
+     * @param mass - mass of the object - must be smaller than 1e21
+     * @param pos - position vector
+     * @param vel - velocity vector
+     * @return asteroid object
+     */
+    static Asteroid* makeAsteroid(Universe& universe, const std::string& name, double mass,
+        const Vector2& pos, const Vector2& vel);
+
     /**
      * Creates a comet with the provided parameters. Adds the object to
      * the singleton Universe
@@ -67,25 +103,54 @@ public:
     static Comet* makeComet(const std::string& name, double mass, const Vector2& pos,
         const Vector2& vel, const std::string& comp);
 
-    // Quick helpers for our solar system
+    /**
+     * Creates a comet in the given universe
+     * @param universe - universe the comet is added to
+     * @param name - name of the object
+     * @param mass - mass of the object
+     * @param pos - position vector
+     * @param vel - velocity vector
+     * @param comp - composition
+     * @return comet object
+     */
+    static Comet* makeComet(Universe& universe, const std::string& name, double mass,
+        const Vector2& pos, const Vector2& vel, const std::string& comp);
+
+    // Quick helpers for our solar system, in the process wide or the given universe
     static Star* makeSun();
+    static Star* makeSun(Universe& universe);
     static Planet* makeMercury();
+    static Planet* makeMercury(Universe& universe);
     static Planet* makeVenus();
+    static Planet* makeVenus(Universe& universe);
     static Planet* makeEarth();
+    static Planet* makeEarth(Universe& universe);
     static Planet* makeMars();
+    static Planet* makeMars(Universe& universe);
     static Planet* makeJupiter();
+    static Planet* makeJupiter(Universe& universe);
     static Planet* makeSaturn();
+    static Planet* makeSaturn(Universe& universe);
     static Planet* makeUranus();
+    static Planet* makeUranus(Universe& universe);
     static Planet* makeNeptune();
+    static Planet* makeNeptune(Universe& universe);
     // Quick helpers for 5 biggest asteroids
     static Asteroid* make1Ceres();
+    static Asteroid* make1Ceres(Universe& universe);
     static Asteroid* make4Vesta();
+    static Asteroid* make4Vesta(Universe& universe);
     static Asteroid* make2Pallas();
+    static Asteroid* make2Pallas(Universe& universe);
     static Asteroid* make10Hygiea();
+    static Asteroid* make10Hygiea(Universe& universe);
     static Asteroid* make704Interamnia();
+    static Asteroid* make704Interamnia(Universe& universe);
     // Quick helpers for famous comets
     static Comet* makeHalley();
+    static Comet* makeHalley(Universe& universe);
     static Comet* makeHaleBopp();
+    static Comet* makeHaleBopp(Universe& universe);
 
 private:
     /**
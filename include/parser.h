@@ -2,8 +2,12 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include "body_store.h"
+#include <cstdint>
 #include <string>
 
+class Universe;
+
 /**
  * Class responsible for loading in custom setup scripts and configuring the
  * Universe appropriately.
@@ -16,6 +20,28 @@ public:
      * @param filename - name of the configuration file to parse
      */
     static void loadFile(const std::string& filename);
+
+    /**
+     * Loads the script file into the given universe instead of the process
+     * wide one
+     * @param universe - universe the objects are added to
+     * @param filename - name of the configuration file to parse
+     */
+    static void loadFile(Universe& universe, const std::string& filename);
+
+    /**
+     * Loads the bodies of a script straight into a store, bypassing the
+     * Universe, so the same scripts drive planar and spatial runs. "pos" and
+     * "vel" may list up to DIM components and the missing ones are zero, so a
+     * planar script loads into a BodyStore3 in the z = 0 plane. Stars sit at
+     * the origin at rest. An optional "radius" sets the physical radius.
+     * @param filename - name of the configuration file to parse
+     * @param bodies - store the bodies are appended to
+     * @throws std::logic_error if the file cannot be read or a vector has
+     * more than DIM components
+     */
+    template <uint32_t DIM>
+    static void loadBodies(const std::string& filename, BasicBodyStore<DIM>& bodies);
 };
 
 #endif // PARSER_H
@@ -0,0 +1,111 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef BARNES_HUT_H
+#define BARNES_HUT_H
+
+#include "./force_solver.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * O(N log N) Barnes-Hut solver. A quadtree over the bodies is rebuilt on every
+ * evaluation and each target walks it, replacing every cell that subtends an
+ * angle below theta (cell width / distance to its center of mass) by a point
+ * mass at its center of mass. theta = 0 degenerates to the direct sum.
+ */
+class BarnesHutSolver : public ForceSolver {
+public:
+    /**
+     * Creates a solver with the given opening angle
+     * @param theta - opening angle, must not be negative
+     */
+    explicit BarnesHutSolver(double theta = 0.5);
+
+    /**
+     * Sets the opening angle. Larger values are faster and less accurate
+     * @param theta - opening angle, must not be negative
+     */
+    void setTheta(double theta);
+
+    /**
+     * Returns the opening angle
+     */
+    [[nodiscard]] double getTheta() const noexcept;
+
+    /**
+     * Returns the number of cells in the tree built by the last evaluation
+     */
+    [[nodiscard]] std::size_t getNodeCount() const noexcept;
+
+protected:
+    /**
+     * Rebuilds the quadtree and walks it once per target. With a thread pool
+     * the subtrees are walked as separate tasks.
+     * @param bodies - current state of the bodies
+     * @param acc - output x and y accelerations
+     */
+    void accumulate(const BodyStore& bodies, const Axes& acc) override;
+
+private:
+    /**
+     * A square cell of the quadtree covering the sorted bodies [begin, end)
+     */
+    struct Node {
+        double size; // Width of the cell in meters
+        double mass; // Total mass inside the cell
+        double comX; // Center of mass, x component
+        double comY; // Center of mass, y component
+        std::uint32_t begin; // First sorted body inside the cell
+        std::uint32_t end; // One past the last sorted body inside the cell
+        std::uint32_t firstChild; // Index of the first child, children are contiguous
+        std::uint32_t childCount; // Number of non-empty children, zero for leaves
+    };
+
+    /**
+     * Sorts the bodies along a Morton curve over their bounding square
+     * @param bodies - current state of the bodies
+     * @return width of the root cell
+     */
+    double sortBodies(const BodyStore& bodies);
+
+    /**
+     * Recursively splits the given node into its non-empty quadrants and
+     * computes the mass moments bottom up
+     * @param index - node to split
+     * @param level - depth of the node, the root is at level 0
+     */
+    void build(std::uint32_t index, std::uint32_t level);
+
+    /**
+     * Walks the tree for the sorted targets [begin, end)
+     * @param begin - first sorted target
+     * @param end - one past the last sorted target
+     * @param stack - scratch stack of the calling worker
+     */
+    void walkRange(std::uint32_t begin, std::uint32_t end, std::vector<std::uint32_t>& stack);
+
+    /**
+     * Walks the tree for a single target. Cells holding the target are
+     * always opened
+     * @param target - sorted index of the target
+     * @param stack - scratch stack of the calling worker
+     * @param ax - accumulated x acceleration
+     * @param ay - accumulated y acceleration
+     */
+    void walk(
+        std::uint32_t target, std::vector<std::uint32_t>& stack, double& ax, double& ay) const;
+
+    double theta; // Opening angle
+    std::vector<Node> nodes; // Tree cells, the root is nodes[0]
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> keys; // Sorted (Morton key, slot) pairs
+    std::vector<double> sortedX; // Body x positions in Morton order
+    std::vector<double> sortedY; // Body y positions in Morton order
+    std::vector<double> sortedMass; // Body masses in Morton order
+    std::vector<double> sortedAx; // Target x accelerations in Morton order
+    std::vector<double> sortedAy; // Target y accelerations in Morton order
+    std::vector<std::vector<std::uint32_t>> stacks; // Scratch walk stack of every worker
+};
+
+#endif // BARNES_HUT_H
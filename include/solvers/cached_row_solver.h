@@ -0,0 +1,142 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef CACHED_ROW_SOLVER_H
+#define CACHED_ROW_SOLVER_H
+
+#include "./force_solver.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Work done by a CachedRowSolver since its creation or the last resetStats()
+ */
+struct RowStats {
+    std::size_t evaluations = 0; // Calls to computeAccelerations, validate() not included
+    std::size_t refreshes = 0; // Evaluations that summed the full rows again
+    std::size_t pairs = 0; // Pairs actually evaluated
+    std::size_t directPairs = 0; // Pairs full row sums would have evaluated
+};
+
+/**
+ * Base class of the direct summation solvers that reuse work between
+ * evaluations. On a refresh every target sums its full row and keeps a list of
+ * the sources to sum on the following evaluations, which reuse the rest.
+ * A refresh happens every getInterval() evaluations, whenever the bodies, the
+ * sources or their masses change, and whenever hasDrifted() says so.
+ * validate() uses the kept work as it is and leaves it, and the statistics,
+ * untouched.
+ * @tparam Stats - statistics of the solver, derived from RowStats
+ */
+template <typename Stats> class CachedRowSolver : public ForceSolver {
+public:
+    /**
+     * Creates a solver refreshing every interval evaluations
+     * @param interval - evaluations between refreshes, must be positive
+     */
+    explicit CachedRowSolver(std::size_t interval);
+
+    /**
+     * Sets the number of evaluations between refreshes
+     * @param interval - evaluations between refreshes, must be positive
+     */
+    void setInterval(std::size_t interval);
+
+    /**
+     * Returns the number of evaluations between refreshes
+     */
+    [[nodiscard]] std::size_t getInterval() const noexcept;
+
+    /**
+     * Returns the work done since creation or the last resetStats()
+     */
+    [[nodiscard]] const Stats& getStats() const noexcept;
+
+    /**
+     * Returns the fraction of the pairs of full row sums that were skipped,
+     * 0 before the first evaluation
+     */
+    [[nodiscard]] double getReduction() const noexcept;
+
+    /**
+     * Clears the statistics
+     */
+    void resetStats() noexcept;
+
+protected:
+    /**
+     * Sums the kept sources of every target, refreshing the rows first when
+     * they are due
+     * @param bodies - current state of the bodies
+     * @param acc - output x and y accelerations
+     */
+    void accumulate(const BodyStore& bodies, const Axes& acc) override;
+
+    /**
+     * Forces a refresh on the next evaluation, for settings that change the
+     * kept work
+     */
+    void invalidate() noexcept;
+
+    /**
+     * Makes room for the work kept for count bodies, before a refresh
+     * @param count - number of bodies
+     */
+    virtual void resize(std::size_t count) = 0;
+
+    /**
+     * Sums the full row of target i and decides which sources it keeps in
+     * lists[i]
+     * @param bodies - current state of the bodies
+     * @param i - slot of the target
+     * @param keep - true to store the kept work of the target, false for validate()
+     * @param ax - output x accelerations
+     * @param ay - output y accelerations
+     */
+    virtual void refreshRow(
+        const BodyStore& bodies, std::size_t i, bool keep, double* ax, double* ay) = 0;
+
+    /**
+     * Sums the kept sources of target i and adds the work reused for the others
+     * @param bodies - current state of the bodies
+     * @param i - slot of the target
+     * @param ax - output x accelerations
+     * @param ay - output y accelerations
+     */
+    virtual void reuseRow(
+        const BodyStore& bodies, std::size_t i, double* ax, double* ay) const = 0;
+
+    /**
+     * Returns true if the bodies have moved too far for the kept work. Never
+     * by default
+     * @param bodies - current state of the bodies
+     */
+    [[nodiscard]] virtual bool hasDrifted(const BodyStore& bodies) const;
+
+    /**
+     * Called after every evaluation but those of validate(), once the pairs
+     * are counted
+     * @param bodies - current state of the bodies
+     * @param refreshed - true if the rows were refreshed
+     */
+    virtual void finish(const BodyStore& bodies, bool refreshed) = 0;
+
+    Stats stats; // Work done so far
+    std::vector<std::vector<std::uint32_t>> lists; // Kept sources of every target, in slot order
+
+private:
+    /**
+     * Returns true if the rows must be refreshed for bodies
+     * @param bodies - current state of the bodies
+     */
+    [[nodiscard]] bool isStale(const BodyStore& bodies) const;
+
+    std::size_t interval; // Evaluations between refreshes
+    bool cached = false; // True once the kept work belongs to the current bodies
+    std::size_t sinceRefresh = 0; // Evaluations since the last refresh
+    std::vector<double> masses; // Active masses at the last refresh
+    std::vector<std::uint32_t> sources; // Sources at the last refresh
+};
+
+#endif // CACHED_ROW_SOLVER_H
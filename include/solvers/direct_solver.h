@@ -0,0 +1,45 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef DIRECT_SOLVER_H
+#define DIRECT_SOLVER_H
+
+#include "./force_solver.h"
+
+/**
+ * Exact O(N^2) summation over every pair of bodies. Each unordered pair is
+ * evaluated once and its pull applied to both bodies with opposite signs
+ * (Newton's third law), so a step costs N(N-1)/2 square roots. This is the
+ * default solver of the Universe and the reference the other solvers are
+ * validated against.
+ *
+ * Test particles (BodyStore::isParticle) only appear as targets: the pairs run
+ * over the S bodies that pull and every particle sums a row of S sources, so a
+ * step costs S(S-1)/2 + (N-S)S square roots.
+ *
+ * With a thread pool every worker sums the full rows of its own targets, which
+ * costs twice the square roots but needs no shared accumulators. The
+ * deterministic mode sums rows without a pool as well, so the result has the
+ * same bits for any number of threads.
+ *
+ * The loops over the axes have DIM iterations known at compile time, so the
+ * planar DirectSolver and the spatial DirectSolver3 each get a kernel of
+ * their own without a branch on the dimension.
+ */
+template <uint32_t DIM> class BasicDirectSolver : public BasicForceSolver<DIM> {
+public:
+    typedef typename BasicForceSolver<DIM>::Axes Axes;
+
+protected:
+    /**
+     * Accumulates the pull of every pair onto both of its bodies, or of every
+     * source onto each target when running in parallel or deterministically
+     * @param bodies - current state of the bodies
+     * @param acc - output accelerations, one array per axis
+     */
+    void accumulate(const BasicBodyStore<DIM>& bodies, const Axes& acc) override;
+};
+
+typedef BasicDirectSolver<2> DirectSolver;
+typedef BasicDirectSolver<3> DirectSolver3;
+
+#endif // DIRECT_SOLVER_H
@@ -0,0 +1,192 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef FMM_H
+#define FMM_H
+
+#include "./force_solver.h"
+#include "thread_pool.h"
+
+#include <complex>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * O(N) two dimensional Fast Multipole Method solver.
+ *
+ * Positions are treated as complex numbers z = x + iy. Our force law is the
+ * in-plane Newtonian 1/r^2 pull, whose potential m / |z - a| is not analytic
+ * in z alone, so the expansions are bivariate in z and conj(z):
+ *
+ *   m / |z - a| = m (z - a)^(-1/2) (conj(z) - conj(a))^(-1/2)
+ *
+ * Multipole coefficients M[k][l] = sum m b^k conj(b)^l and local coefficients
+ * L[n][m] (potential = sum L[n][m] t^n conj(t)^m) are kept for all k + l <= p,
+ * where p is the expansion order. All translations (M2M, M2L, L2L) are exact
+ * binomial re-expansions of that truncated series, the acceleration is
+ * 2 G dPhi/d(conj z). Coefficients are scaled by the cell width to stay finite
+ * at astronomical distances.
+ *
+ * The tree has uniform depth, chosen as the shallowest level whose occupied
+ * leaves hold at most getLeafSize() bodies on average. Only occupied cells are
+ * stored. Neighbouring leaves interact directly.
+ *
+ * With a thread pool the downward pass and the leaf evaluation are split into
+ * tasks over the cells of each level.
+ */
+class FmmSolver : public ForceSolver {
+public:
+    /**
+     * Creates a solver with the given expansion order
+     * @param order - highest total degree of the expansions, between 1 and MAX_ORDER
+     */
+    explicit FmmSolver(std::uint32_t order = 12);
+
+    static constexpr std::uint32_t MAX_ORDER = 40; // Largest supported expansion order
+
+    /**
+     * Sets the expansion order. Higher orders are slower and more accurate
+     * @param order - highest total degree of the expansions, between 1 and MAX_ORDER
+     */
+    void setOrder(std::uint32_t order);
+
+    /**
+     * Returns the expansion order
+     */
+    [[nodiscard]] std::uint32_t getOrder() const noexcept;
+
+    /**
+     * Picks the lowest expansion order whose truncation error bound is below
+     * tolerance. The relative error of the acceleration shrinks by a factor of
+     * 0.4 to 0.5 per order with the standard interaction lists, the bound
+     * assumes the slower rate.
+     * @param tolerance - target relative error, between 0 and 1 exclusive
+     */
+    void setTolerance(double tolerance);
+
+    /**
+     * Sets the target number of bodies per occupied leaf
+     * @param bodies - average leaf occupancy to aim for, must be positive
+     */
+    void setLeafSize(std::uint32_t bodies);
+
+    /**
+     * Returns the target number of bodies per occupied leaf
+     */
+    [[nodiscard]] std::uint32_t getLeafSize() const noexcept;
+
+    /**
+     * Returns the depth of the tree built by the last evaluation
+     */
+    [[nodiscard]] std::uint32_t getDepth() const noexcept;
+
+protected:
+    /**
+     * Runs the upward pass, the interaction lists, the downward pass and the
+     * near field sums
+     * @param bodies - current state of the bodies
+     * @param acc - output x and y accelerations
+     */
+    void accumulate(const BodyStore& bodies, const Axes& acc) override;
+
+private:
+    typedef std::complex<double> Complex;
+
+    /**
+     * An occupied cell of the tree covering the sorted bodies [begin, end)
+     */
+    struct Cell {
+        std::uint64_t key; // Morton key of the cell at its level
+        std::uint32_t begin; // First sorted body inside the cell
+        std::uint32_t end; // One past the last sorted body inside the cell
+    };
+
+    /**
+     * All occupied cells of one level of the tree
+     */
+    struct Level {
+        double width; // Width of a cell at this level in meters
+        std::vector<Cell> cells; // Occupied cells in Morton order
+        std::unordered_map<std::uint64_t, std::uint32_t> lookup; // Key to index into cells
+        std::vector<Complex> multipole; // Scaled multipole coefficients, terms() per cell
+        std::vector<Complex> local; // Scaled local coefficients, terms() per cell
+    };
+
+    /**
+     * Returns the number of coefficients of an expansion
+     */
+    [[nodiscard]] std::size_t terms() const noexcept;
+
+    /**
+     * Returns the position of coefficient [k][l] (k + l <= order) in an expansion
+     */
+    [[nodiscard]] std::size_t index(std::uint32_t k, std::uint32_t l) const noexcept;
+
+    /**
+     * Returns the center of a cell as a complex number
+     */
+    [[nodiscard]] Complex center(const Level& level, const Cell& cell) const noexcept;
+
+    /**
+     * Sorts the bodies along a Morton curve, chooses the depth and creates the
+     * occupied cells of every level
+     * @param bodies - current state of the bodies
+     */
+    void buildTree(const BodyStore& bodies);
+
+    /**
+     * Forms the leaf multipoles and translates them up the tree
+     */
+    void upwardPass();
+
+    /**
+     * Converts the multipole of a well separated source cell into the local
+     * expansion of a target cell and adds it
+     * @param source - scaled multipole of the source cell
+     * @param offset - target center minus source center
+     * @param width - cell width at the level of both cells
+     * @param target - scaled local expansion to add to
+     * @param work - scratch space of the calling worker
+     */
+    void multipoleToLocal(const Complex* source, Complex offset, double width, Complex* target,
+        std::vector<Complex>& work) const;
+
+    /**
+     * Runs the interaction lists and translates the local expansions down
+     */
+    void downwardPass();
+
+    /**
+     * Evaluates the leaf local expansions and the near field for every target,
+     * in Morton order
+     */
+    void evaluate();
+
+    /**
+     * Runs task over the cell range [0, count), split over the thread pool if
+     * there is one
+     * @param count - number of cells
+     * @param task - called with a [begin, end) range of cells and the worker
+     */
+    void forEachCell(std::size_t count, const ThreadPool::RangeTask& task);
+
+    std::uint32_t order; // Highest total degree of the expansions
+    std::uint32_t leafSize = 32; // Target number of bodies per occupied leaf
+    std::vector<double> binomial; // binomial[n * (order + 1) + k] = n choose k
+    std::vector<double> halfBinomial; // [k * (order + 1) + n] = (-k - 1/2 choose n)
+    std::vector<double> sqrtSeries; // sqrtSeries[k] = (2k choose k) / 4^k
+
+    double originX = 0.0; // Lower left corner of the root cell
+    double originY = 0.0; // Lower left corner of the root cell
+    std::vector<Level> levels; // levels[l] holds the cells of width rootWidth / 2^l
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> keys; // Sorted (Morton key, slot) pairs
+    std::vector<double> sortedX; // Body x positions in Morton order
+    std::vector<double> sortedY; // Body y positions in Morton order
+    std::vector<double> sortedMass; // Body masses in Morton order
+    std::vector<double> sortedAx; // Target x accelerations in Morton order
+    std::vector<double> sortedAy; // Target y accelerations in Morton order
+    std::vector<std::vector<Complex>> scratch; // Intermediate sums of multipoleToLocal per worker
+};
+
+#endif // FMM_H
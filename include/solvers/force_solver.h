@@ -0,0 +1,161 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef FORCE_SOLVER_H
+#define FORCE_SOLVER_H
+
+#include "body_store.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * Error of a force evaluation measured against the direct O(N^2) sum. Only the
+ * bodies that move (every slot but the first) are taken into account.
+ */
+struct ForceError {
+    double maxRelative = 0.0; // Largest |a - a_direct| / |a_direct| over all bodies
+    double rmsRelative = 0.0; // Root mean square of the per-body relative errors
+};
+
+/**
+ * Abstract base class of the strategies computing the gravitational
+ * acceleration of every body in a BodyStore. The Universe owns exactly one
+ * solver and calls it from stepSimulation. ForceSolver works on the planar
+ * BodyStore and ForceSolver3 on BodyStore3; the tree and multipole solvers
+ * are planar only.
+ */
+template <uint32_t DIM> class BasicForceSolver {
+public:
+    typedef std::array<double*, DIM> Axes; // One output array per axis
+
+    // Default constructor
+    BasicForceSolver() = default;
+    // Default destructor
+    virtual ~BasicForceSolver() = default;
+    // Copy and assignment not allowed
+    BasicForceSolver(const BasicForceSolver&) = delete;
+    BasicForceSolver& operator=(const BasicForceSolver&) = delete;
+
+    /**
+     * Fills acc with the acceleration of every body in bodies. The first body
+     * is the fixed sun and is not a target, so its entries are zero. When
+     * validation is enabled the result is also compared against the direct sum
+     * and the error is available from getLastError().
+     * @param bodies - current state of the bodies
+     * @param acc - output accelerations, every array at least bodies.size() long
+     */
+    void computeAccelerations(const BasicBodyStore<DIM>& bodies, const Axes& acc);
+
+    /**
+     * Planar shorthand of computeAccelerations
+     * @param bodies - current state of the bodies
+     * @param ax - output x accelerations, at least bodies.size() long
+     * @param ay - output y accelerations, at least bodies.size() long
+     */
+    void computeAccelerations(const BasicBodyStore<DIM>& bodies, double* ax, double* ay)
+        requires(DIM == 2);
+
+    /**
+     * Enables or disables the validation mode. Validation runs the direct
+     * O(N^2) sum next to every evaluation and is meant for debugging only.
+     * @param enabled - true to compare every evaluation against the direct sum
+     */
+    void setValidation(bool enabled) noexcept;
+
+    /**
+     * Returns true if the validation mode is enabled
+     */
+    [[nodiscard]] bool getValidation() const noexcept;
+
+    /**
+     * Returns the error of the most recent validated evaluation
+     */
+    [[nodiscard]] const ForceError& getLastError() const noexcept;
+
+    /**
+     * Evaluates bodies once and measures the result against the direct sum,
+     * regardless of the validation mode. Solvers that keep work between
+     * evaluations use it as it is but do not update it, nor their statistics
+     * @param bodies - state of the bodies to evaluate
+     * @return error of this solver for the given state
+     */
+    ForceError validate(const BasicBodyStore<DIM>& bodies);
+
+    /**
+     * Enables or disables the deterministic mode. Every acceleration is then
+     * summed in an order fixed by the slots alone, so a run gives the same
+     * bits with any thread count and any scheduling. Only DirectSolver sums
+     * differently without it (its serial pair loop). The other solvers always
+     * sum that way and ignore the flag: in the row solvers every target sums
+     * its sources in slot order, whichever worker takes it.
+     * @param enabled - true to make the result independent of the threads
+     */
+    void setDeterministic(bool enabled) noexcept;
+
+    /**
+     * Returns true if the deterministic mode is enabled
+     */
+    [[nodiscard]] bool getDeterministic() const noexcept;
+
+    /**
+     * Lets the solver split its work over the workers of a pool. Solvers that
+     * cannot run in parallel ignore it. A pool with a single worker, or none,
+     * runs the serial code.
+     * @param pool - pool owned by the caller, or null for serial evaluation
+     */
+    void setThreadPool(ThreadPool* pool) noexcept;
+
+    /**
+     * Returns the pool set by setThreadPool, or null
+     */
+    [[nodiscard]] ThreadPool* getThreadPool() const noexcept;
+
+    /**
+     * Returns a counter bumped by every setting that can change the
+     * accelerations, so a caller caching them can tell they are stale
+     */
+    [[nodiscard]] std::uint64_t getGeneration() const noexcept;
+
+protected:
+    /**
+     * Returns true if a pool with more than one worker is available
+     */
+    [[nodiscard]] bool isParallel() const noexcept;
+
+    /**
+     * Returns true while validate() evaluates. Solvers that keep work between
+     * evaluations must then leave it, and their statistics, untouched
+     */
+    [[nodiscard]] bool isProbing() const noexcept;
+
+    /**
+     * Bumps the generation. Every setter that can change the accelerations
+     * calls it
+     */
+    void touch() noexcept;
+
+    /**
+     * Solver specific evaluation, with the same contract as computeAccelerations
+     * @param bodies - current state of the bodies
+     * @param acc - output accelerations, one array per axis
+     */
+    virtual void accumulate(const BasicBodyStore<DIM>& bodies, const Axes& acc) = 0;
+
+private:
+    ThreadPool* pool = nullptr; // Workers to split the evaluation over, not owned
+    bool validation = false; // Compare every evaluation against the direct sum
+    bool deterministic = false; // Sum in an order independent of the threads
+    bool probing = false; // True while validate() evaluates
+    std::uint64_t generation = 0; // Bumped by every setting that changes the result
+    ForceError lastError; // Error of the most recent validated evaluation
+    std::array<std::vector<double>, DIM> reference; // Scratch direct sum for validation
+};
+
+typedef BasicForceSolver<2> ForceSolver;
+typedef BasicForceSolver<3> ForceSolver3;
+
+#endif // FORCE_SOLVER_H
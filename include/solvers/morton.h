@@ -0,0 +1,56 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef MORTON_H
+#define MORTON_H
+
+#include <cstdint>
+
+/**
+ * Helpers for the Z-order (Morton) keys the tree solvers sort bodies by. Keys
+ * interleave 31 bits per axis, x in the even bits and y in the odd bits, so the
+ * two most significant bits of a key select the quadrant of the root cell.
+ */
+namespace morton {
+
+constexpr std::uint32_t BITS = 31; // Bits per axis
+constexpr double GRID = 2147483647.0; // Largest coordinate on the 31 bit grid
+
+/**
+ * Spreads the low 32 bits of v over the even bits of the result
+ */
+inline std::uint64_t spreadBits(std::uint64_t v)
+{
+    v &= 0xffffffffULL;
+    v = (v | (v << 16)) & 0x0000ffff0000ffffULL;
+    v = (v | (v << 8)) & 0x00ff00ff00ff00ffULL;
+    v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    v = (v | (v << 2)) & 0x3333333333333333ULL;
+    v = (v | (v << 1)) & 0x5555555555555555ULL;
+    return v;
+}
+
+/**
+ * Gathers the even bits of v into the low 32 bits of the result
+ */
+inline std::uint64_t compactBits(std::uint64_t v)
+{
+    v &= 0x5555555555555555ULL;
+    v = (v | (v >> 1)) & 0x3333333333333333ULL;
+    v = (v | (v >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+    v = (v | (v >> 4)) & 0x00ff00ff00ff00ffULL;
+    v = (v | (v >> 8)) & 0x0000ffff0000ffffULL;
+    v = (v | (v >> 16)) & 0x00000000ffffffffULL;
+    return v;
+}
+
+/**
+ * Interleaves the grid coordinates qx and qy into a key
+ */
+inline std::uint64_t encode(std::uint64_t qx, std::uint64_t qy)
+{
+    return spreadBits(qx) | (spreadBits(qy) << 1);
+}
+
+} // namespace morton
+
+#endif // MORTON_H
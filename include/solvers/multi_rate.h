@@ -0,0 +1,120 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef MULTI_RATE_H
+#define MULTI_RATE_H
+
+#include "./cached_row_solver.h"
+
+#include <cstddef>
+#include <vector>
+
+typedef RowStats MultiRateStats; // Work done by a MultiRateSolver, a refresh sums the slow pulls
+
+/**
+ * Multi-rate direct summation. The pull on every target is split into a fast
+ * part, from the sun and from the sources closer than getNearFactor() times
+ * the distance of the target from the sun, and a slow part from every other
+ * source. The pull of Neptune on Mercury, say, hardly changes over an hour, so
+ * the slow part is summed only on a refresh and reused in between, while the
+ * fast part is summed on every evaluation.
+ *
+ * The split is decided on every refresh. A refresh happens every getInterval()
+ * evaluations, and earlier when any body has moved more than getDrift() times
+ * the shortest slow separation since the last one, or when the bodies, the
+ * sources or their masses change. Interval 1 refreshes on every evaluation
+ * and gives the direct sum up to rounding.
+ *
+ * The result does not depend on the threads (see setDeterministic()). Use
+ * validate() or the validation mode to measure the error of a setting and
+ * getStats() for the pairs it saved.
+ */
+class MultiRateSolver : public CachedRowSolver<MultiRateStats> {
+public:
+    /**
+     * Creates a solver with the given accuracy knobs
+     * @param interval - evaluations between refreshes, must be positive
+     * @param nearFactor - fraction of the distance from the sun below which a
+     * source is fast, must not be negative
+     * @param drift - fraction of the shortest slow separation a body may move
+     * before a refresh, must not be negative
+     */
+    explicit MultiRateSolver(
+        std::size_t interval = 8, double nearFactor = 0.5, double drift = 0.05);
+
+    /**
+     * Sets the near factor. Larger values sum more sources on every evaluation
+     * @param nearFactor - fraction of the distance from the sun below which a
+     * source is fast, must not be negative
+     */
+    void setNearFactor(double nearFactor);
+
+    /**
+     * Returns the near factor
+     */
+    [[nodiscard]] double getNearFactor() const noexcept;
+
+    /**
+     * Sets how far a body may move before the slow pulls are refreshed early
+     * @param drift - fraction of the shortest slow separation, must not be negative
+     */
+    void setDrift(double drift);
+
+    /**
+     * Returns the drift threshold
+     */
+    [[nodiscard]] double getDrift() const noexcept;
+
+protected:
+    /**
+     * Makes room for the slow pulls of count bodies
+     * @param count - number of bodies
+     */
+    void resize(std::size_t count) override;
+
+    /**
+     * Sums the full row of target i, splitting it into fast and slow sources
+     * @param bodies - current state of the bodies
+     * @param i - slot of the target
+     * @param keep - true to cache the split and the slow pull of the target
+     * @param ax - output x accelerations
+     * @param ay - output y accelerations
+     */
+    void refreshRow(
+        const BodyStore& bodies, std::size_t i, bool keep, double* ax, double* ay) override;
+
+    /**
+     * Sums the fast sources of target i and adds its cached slow pull
+     * @param bodies - current state of the bodies
+     * @param i - slot of the target
+     * @param ax - output x accelerations
+     * @param ay - output y accelerations
+     */
+    void reuseRow(
+        const BodyStore& bodies, std::size_t i, double* ax, double* ay) const override;
+
+    /**
+     * Returns true if a body has moved more than getDrift() times the
+     * shortest slow separation since the last refresh
+     * @param bodies - current state of the bodies
+     */
+    [[nodiscard]] bool hasDrifted(const BodyStore& bodies) const override;
+
+    /**
+     * Records the positions and the drift limit of a refresh
+     * @param bodies - current state of the bodies
+     * @param refreshed - true if the slow pulls were summed again
+     */
+    void finish(const BodyStore& bodies, bool refreshed) override;
+
+private:
+    double nearFactor; // Fraction of the distance from the sun below which a source is fast
+    double drift; // Fraction of the shortest slow separation a body may move
+    std::vector<double> slowX; // Cached slow x pull of every target
+    std::vector<double> slowY; // Cached slow y pull of every target
+    std::vector<double> closestSq; // Shortest slow separation of every target, squared
+    std::vector<double> anchorX; // x positions at the last refresh
+    std::vector<double> anchorY; // y positions at the last refresh
+    double limitSq = 0.0; // Squared distance a body may move before a refresh
+};
+
+#endif // MULTI_RATE_H
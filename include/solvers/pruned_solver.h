@@ -0,0 +1,103 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef PRUNED_SOLVER_H
+#define PRUNED_SOLVER_H
+
+#include "./cached_row_solver.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Work done and force neglected by a PrunedSolver since its creation or the
+ * last resetStats(). A refresh rebuilds the interaction lists.
+ */
+struct PrunedStats : RowStats {
+    double neglectedRelative = 0.0; // Largest dropped pull over the pull of the sun, last rebuild
+    double neglectedSum = 0.0; // Largest dropped pull in m/s^2, summed over the evaluations
+};
+
+/**
+ * Direct summation over pruned interaction lists. In a population of small
+ * asteroids and comets most pairs pull many orders of magnitude less than the
+ * sun, so every target keeps a list of the sources whose pull is at least
+ * getThreshold() times the pull of the sun on it and sums only those. The sun
+ * is always kept.
+ *
+ * The lists are rebuilt from the full rows every getInterval() evaluations,
+ * which re-checks the dropped pairs, and whenever the bodies, the sources or
+ * their masses change. A rebuild also measures the magnitude of the pull every
+ * target drops, reported by getStats() relative to the pull of the sun and,
+ * summed over the evaluations, in m/s^2: times the time step that sum bounds
+ * the velocity error the pruning has caused so far, as long as no dropped pair
+ * closes in much between rebuilds. For a sparse, sun dominated system the
+ * lists stay short and an evaluation between rebuilds costs close to O(N).
+ *
+ * The result does not depend on the threads (see setDeterministic()).
+ * Threshold 0 keeps every pair.
+ */
+class PrunedSolver : public CachedRowSolver<PrunedStats> {
+public:
+    /**
+     * Creates a solver with the given cutoff
+     * @param threshold - pull relative to the sun below which a pair is
+     * dropped, must not be negative
+     * @param interval - evaluations between rebuilds, must be positive
+     */
+    explicit PrunedSolver(double threshold = 1e-6, std::size_t interval = 16);
+
+    /**
+     * Sets the cutoff. Larger values drop more pairs
+     * @param threshold - pull relative to the sun below which a pair is
+     * dropped, must not be negative
+     */
+    void setThreshold(double threshold);
+
+    /**
+     * Returns the cutoff
+     */
+    [[nodiscard]] double getThreshold() const noexcept;
+
+protected:
+    /**
+     * Makes room for the dropped pulls of count bodies
+     * @param count - number of bodies
+     */
+    void resize(std::size_t count) override;
+
+    /**
+     * Sums the full row of target i and keeps the sources above the cutoff
+     * @param bodies - current state of the bodies
+     * @param i - slot of the target
+     * @param keep - true to store the list and the dropped pull of the target
+     * @param ax - output x accelerations
+     * @param ay - output y accelerations
+     */
+    void refreshRow(
+        const BodyStore& bodies, std::size_t i, bool keep, double* ax, double* ay) override;
+
+    /**
+     * Sums the interaction list of target i
+     * @param bodies - current state of the bodies
+     * @param i - slot of the target
+     * @param ax - output x accelerations
+     * @param ay - output y accelerations
+     */
+    void reuseRow(
+        const BodyStore& bodies, std::size_t i, double* ax, double* ay) const override;
+
+    /**
+     * Measures the pull dropped by a rebuild and adds it to the statistics
+     * @param bodies - current state of the bodies
+     * @param refreshed - true if the lists were rebuilt
+     */
+    void finish(const BodyStore& bodies, bool refreshed) override;
+
+private:
+    double threshold; // Pull relative to the sun below which a pair is dropped
+    double neglected = 0.0; // Largest dropped pull of the last rebuild, in m/s^2
+    std::vector<double> droppedPull; // Magnitude of the dropped pull of every target
+    std::vector<double> sunPull; // Magnitude of the pull of the sun on every target
+};
+
+#endif // PRUNED_SOLVER_H
@@ -0,0 +1,132 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef SIMD_SOLVER_H
+#define SIMD_SOLVER_H
+
+#include "./force_solver.h"
+#include "thread_pool.h"
+
+#include <vector>
+
+/**
+ * Instruction sets the vectorized kernels are available for
+ */
+enum class SimdLevel {
+    Scalar, // Portable C++ fallback
+    Avx2, // 4 doubles per register, with FMA
+    Avx512 // 8 doubles per register
+};
+
+/**
+ * Arithmetic used for the pairwise interactions
+ */
+enum class SimdPrecision {
+    Double, // Every pair in double
+    Mixed // Every pair in float relative to a local origin, sums in double
+};
+
+/**
+ * Vectorized, cache tiled all-pairs solver. Targets are processed a register
+ * width at a time against tiles of sources that fit in cache. The widest
+ * instruction set supported by the running CPU is picked at construction.
+ * With a thread pool every worker takes a contiguous block of targets.
+ *
+ * Targets do not use the pair symmetry of DirectSolver. Test particles are
+ * left out of the gathered sources. The scalar kernel uses IEEE division and
+ * square root, the AVX2/AVX-512 kernels a Newton refined reciprocal square
+ * root and fused multiply-adds. Workers take whole blocks of targets, so every
+ * target goes through the same kernel whatever the thread count (see
+ * setDeterministic()).
+ * Accelerations agree with DirectSolver to a relative error below 1e-12 (see
+ * SIMD_TOLERANCE).
+ *
+ * The mixed precision mode halves the width of every lane, so a register holds
+ * twice as many pairs. Positions and velocities stay in double. Every group of
+ * 256 targets takes its first target as a local origin, and every tile of
+ * sources is re-based onto it: the offsets, scaled by a power of two, are split
+ * into a float and the float of the remainder, so a pair keeps about 48 bits of
+ * its separation wherever it is. Every pair is then computed in float, and
+ * every run of 64 sources is summed in float before it is added to double
+ * sums. The error of a pair is that of float arithmetic, about 1e-7 relative,
+ * so the error of a target grows with how much its pulls cancel. Use
+ * validate() to measure it for a given state; for the asteroid belt it stays
+ * below MIXED_TOLERANCE. Only the AVX2/AVX-512 kernels are faster than double.
+ */
+class SimdSolver : public ForceSolver {
+public:
+    static constexpr double SIMD_TOLERANCE = 1e-12; // Documented max relative deviation
+    static constexpr double MIXED_TOLERANCE = 1e-5; // Same, with mixed precision
+
+    /**
+     * Creates a solver using the widest instruction set the CPU supports
+     */
+    SimdSolver();
+
+    /**
+     * Returns the widest instruction set supported by the running CPU
+     */
+    [[nodiscard]] static SimdLevel detect() noexcept;
+
+    /**
+     * Selects the kernel to use. Requests above what the CPU supports fall
+     * back to the widest supported level
+     * @param level - requested instruction set
+     */
+    void setLevel(SimdLevel level) noexcept;
+
+    /**
+     * Returns the instruction set of the kernel in use
+     */
+    [[nodiscard]] SimdLevel getLevel() const noexcept;
+
+    /**
+     * Selects the arithmetic of the pairwise interactions
+     * @param precision - Double (default) or Mixed
+     */
+    void setPrecision(SimdPrecision precision) noexcept;
+
+    /**
+     * Returns the arithmetic of the pairwise interactions
+     */
+    [[nodiscard]] SimdPrecision getPrecision() const noexcept;
+
+protected:
+    /**
+     * Runs the all-pairs kernel for every target
+     * @param bodies - current state of the bodies
+     * @param acc - output x and y accelerations
+     */
+    void accumulate(const BodyStore& bodies, const Axes& acc) override;
+
+private:
+    /**
+     * Runs sweep over the targets [0, count), split over the thread pool in
+     * blocks of whole registers if there is one
+     * @param count - number of targets
+     * @param sweep - called with [begin, end) ranges of targets and the worker
+     */
+    void sweepTargets(std::size_t count, const ThreadPool::RangeTask& sweep);
+
+    /**
+     * Mixed precision version of accumulate
+     * @param bodies - current state of the bodies
+     * @param ax - output x accelerations
+     * @param ay - output y accelerations
+     */
+    void accumulateMixed(const BodyStore& bodies, double* ax, double* ay);
+
+    /**
+     * Gathers the positions and pulls of the sources of bodies, test particles
+     * only feel the others. Returns the number of sources
+     * @param bodies - current state of the bodies
+     */
+    [[nodiscard]] std::size_t gatherSources(const BodyStore& bodies);
+
+    SimdLevel level; // Instruction set of the kernel in use
+    SimdPrecision precision = SimdPrecision::Double; // Arithmetic of the pairs
+    std::vector<double> sourceX; // x positions of the sources, gathered
+    std::vector<double> sourceY; // y positions of the sources, gathered
+    std::vector<double> pull; // G times the mass of every source
+};
+
+#endif // SIMD_SOLVER_H
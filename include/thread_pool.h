@@ -0,0 +1,186 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Work-stealing task scheduler over a fixed set of worker threads that live as
+ * long as the pool, so a step costs a wake up instead of a thread creation.
+ *
+ * Every worker owns a deque of tasks. It pushes and pops at the back, which
+ * keeps recently split work hot in its cache, and idle workers steal from the
+ * front, where the oldest and therefore largest pieces of a split sit. The
+ * thread driving the pool (the one calling parallelFor() or TaskGroup::wait())
+ * acts as worker 0 and executes tasks while it waits. Only one outside thread
+ * may drive a pool at a time.
+ */
+class ThreadPool {
+public:
+    typedef std::function<void()> Task;
+    typedef std::function<void(std::size_t begin, std::size_t end, std::size_t worker)> RangeTask;
+
+    // Split points are multiples of this, 64 bytes of doubles, so workers
+    // writing neighbouring ranges of a double array share at most one cache
+    // line at each boundary (none if the array starts on a 64 byte boundary,
+    // which std::vector does not promise). This reduces false sharing.
+    static constexpr std::size_t CHUNK_ALIGN = 8;
+
+    /**
+     * Counters of one worker, reset by resetStats()
+     */
+    struct WorkerStats {
+        std::uint64_t tasks = 0; // Tasks executed, stolen or not
+        std::uint64_t steals = 0; // Tasks taken from another worker's deque
+        double busySeconds = 0.0; // Time spent executing tasks
+    };
+
+    /**
+     * A set of tasks that can be waited on together. Tasks may add more tasks
+     * to their own group, which is how recursive traversals split their work.
+     */
+    class TaskGroup {
+    public:
+        /**
+         * Creates an empty group
+         * @param pool - pool to run the tasks on
+         */
+        explicit TaskGroup(ThreadPool& pool) noexcept;
+
+        /**
+         * Waits for the outstanding tasks, dropping their exceptions
+         */
+        ~TaskGroup();
+
+        // Copy and assignment not allowed
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /**
+         * Pushes a task onto the deque of the calling worker
+         * @param task - work to run on any worker
+         */
+        void run(Task task);
+
+        /**
+         * Executes queued tasks until every task of the group has finished. The
+         * first exception thrown by a task of the group is rethrown here.
+         */
+        void wait();
+
+    private:
+        friend class ThreadPool;
+
+        ThreadPool& pool; // Pool running the tasks
+        std::atomic<std::size_t> pending = 0; // Tasks queued or running
+        std::mutex lock; // Guards failure
+        std::exception_ptr failure; // First exception thrown by a task
+    };
+
+    /**
+     * Starts workers - 1 threads, the thread driving the pool is worker 0
+     * @param workers - total number of workers, must be positive
+     */
+    explicit ThreadPool(std::size_t workers);
+
+    /**
+     * Stops and joins every thread
+     */
+    ~ThreadPool();
+
+    // Copy and assignment not allowed
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Returns the total number of workers, including the driving thread
+     */
+    [[nodiscard]] std::size_t getWorkerCount() const noexcept;
+
+    /**
+     * Returns the index of the calling thread in this pool, 0 for the driving
+     * thread and any other thread outside the pool
+     */
+    [[nodiscard]] std::size_t currentWorker() const noexcept;
+
+    /**
+     * Runs task over [0, count) and waits for it. The range is split in halves
+     * down to grain indices, the halves are left for idle workers to steal. A
+     * pool with a single worker calls task(0, count, 0) directly. The first
+     * exception thrown by a chunk is rethrown here once every chunk is done.
+     * @param count - size of the index range
+     * @param task - called with a [begin, end) chunk and the executing worker
+     * @param grain - smallest chunk worth splitting off, 0 for about four
+     * chunks per worker
+     */
+    void parallelFor(std::size_t count, const RangeTask& task, std::size_t grain = 0);
+
+    /**
+     * Returns the counters of every worker
+     */
+    [[nodiscard]] std::vector<WorkerStats> getStats() const;
+
+    /**
+     * Sets every counter back to zero
+     */
+    void resetStats() noexcept;
+
+private:
+    /**
+     * A queued task and the group waiting for it
+     */
+    struct Job {
+        Task task; // Work to run
+        TaskGroup* group; // Group to notify when done
+    };
+
+    /**
+     * Deque and counters of one worker, on a cache line of its own
+     */
+    struct alignas(64) Worker {
+        std::mutex lock; // Guards jobs
+        std::deque<Job> jobs; // Back is the owner's end, front is the thieves' end
+        std::atomic<std::uint64_t> tasks = 0; // Tasks executed
+        std::atomic<std::uint64_t> steals = 0; // Tasks stolen from other workers
+        std::atomic<std::uint64_t> busyNanos = 0; // Time spent executing tasks
+    };
+
+    /**
+     * Queues a job on the deque of the calling worker and wakes a sleeper
+     */
+    void push(Job job);
+
+    /**
+     * Pops a job of the worker's own deque or steals one and runs it
+     * @param self - index of the calling worker
+     * @return false if every deque was empty
+     */
+    bool runOne(std::size_t self);
+
+    /**
+     * Main loop of the background threads
+     * @param self - index of the worker, between 1 and getWorkerCount() - 1
+     */
+    void work(std::size_t self);
+
+    std::size_t workers; // Total number of workers, including the driving thread
+    std::unique_ptr<Worker[]> slots; // Per worker deques and counters
+    std::vector<std::thread> threads; // Background workers 1 .. workers - 1
+    std::atomic<std::size_t> queued = 0; // Jobs sitting in any deque
+    std::mutex sleepLock; // Guards the sleep of idle workers
+    std::condition_variable sleep; // Signals queued jobs or shutdown
+    bool stopping = false; // Set by the destructor, guarded by sleepLock
+};
+
+#endif // THREAD_POOL_H
@@ -2,16 +2,48 @@
 #ifndef UNIVERSE_H
 #define UNIVERSE_H
 
+#include "./body_store.h"
+#include "./collision_detector.h"
 #include "./vector.h"
+#include "integrators/dormand_prince.h"
+#include "integrators/integrator.h"
+#include "integrators/kepler_propagator.h"
+#include "solvers/force_solver.h"
+#include "thread_pool.h"
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
 class Object;
 class ObjectFactory;
+class Visitor;
+
+/**
+ * An impact or close encounter seen by the Universe at the end of a step
+ */
+struct CollisionEvent {
+    double time = 0.0; // Simulated time at the end of the step, in seconds
+    std::string first; // Name of the body in the lower slot
+    std::string second; // Name of the body in the higher slot
+    double distance = 0.0; // Distance between the centers, in meters
+    bool impact = false; // True if the bodies touched
+    bool merged = false; // True if the lighter body was absorbed by the heavier one
+};
 
 /**
  * A singleton class representing the Universe. For this assignment, the first
  * object added to the Universe will be considered unmovable and so its
  * position should not be changed.
+ *
+ * The dynamic state of every registered Object lives in a BodyStore owned by
+ * the Universe; the Objects themselves are handles onto it.
+ *
+ * Besides the process wide instance, independent Universes can be constructed
+ * directly and filled through the ObjectFactory and Parser overloads taking a
+ * Universe. They share no state, so different threads may step different
+ * Universes at the same time (see EnsembleRunner).
  */
 class Universe {
 public:
@@ -20,17 +52,39 @@ public:
     typedef std::vector<Object*>::const_iterator const_iterator;
 
     static constexpr double G = 6.67428e-11;
+    // Called with the simulated time and the state by advance() and advanceUntil()
+    typedef std::function<void(double time, const BodyStore& state)> Sampler;
+
+    static constexpr std::size_t KEPLER_RECHECK = 100; // Steps between two Kepler classifications
+
+    // What stepSimulation does about bodies that touch or pass close
+    enum class CollisionMode {
+        Off, // Nothing is checked, the default
+        Record, // Impacts and close encounters are recorded
+        Merge // Recorded as well, and touching bodies merge into one
+    };
 
     /**
-     * Returns the only instance of the Universe
+     * Returns the process wide instance of the Universe, creating it on the
+     * first call
      */
     static Universe* instance();
 
+    /**
+     * Creates an empty Universe independent of the process wide instance,
+     * with a DirectSolver and an EulerIntegrator
+     */
+    Universe();
+
     /**
      * Releases all the dynamic objects still registered with the Universe.
      */
     ~Universe();
 
+    // Copy and assignment not allowed
+    Universe(const Universe&) = delete;
+    Universe& operator=(const Universe&) = delete;
+
     /**
      * Returns the begin iterator to the actual Objects. The order of iteration
      * will be the same as that over getSnapshot()'s result as long as no new
@@ -62,31 +116,257 @@ public:
     /**
      * Returns a container of copies of all the Objects registered with the
      * Universe. This should be used as the source of data for computing the
-     * next step in the simulation
+     * next step in the simulation. Every call clones every Object, snapshot()
+     * freezes the same state without allocating.
      */
     [[nodiscard]] std::vector<Object*> getSnapshot() const;
 
     /**
-     * Advances the simulation by the provided time step. For this assignment,
-     * you must assume that the first registered object is a "sun" and its
-     * position should not be affected by any of the other objects
+     * Copies the current state into the older of two snapshot buffers and
+     * returns a read-only view of it. The view is not affected by later steps
+     * and stays valid until the next but one call, so the previous snapshot
+     * can still be compared with the new one. The buffers keep their capacity,
+     * so once both have held the current number of bodies no call allocates.
+     * Slot i of the view belongs to the ith Object in iteration order.
+     */
+    [[nodiscard]] const BodyStore& snapshot();
+
+    /**
+     * Writes a state frozen by snapshot() back into the registered Objects,
+     * without allocating, and rewinds the simulated time to the time of the
+     * snapshot.
+     * @param state - view returned by snapshot(), as many bodies as the Universe
+     * @throws std::logic_error if state is not a snapshot() buffer or does not
+     * match the registered objects
+     */
+    void restore(const BodyStore& state);
+
+    /**
+     * Returns the structure-of-arrays store backing the registered Objects.
+     * Slot i of the store belongs to the ith Object in iteration order.
+     */
+    [[nodiscard]] const BodyStore& getBodies() const noexcept;
+
+    /**
+     * Replaces the strategy used to compute the forces in stepSimulation. The
+     * Universe starts out with a DirectSolver.
+     * @param solver - new force solver, must not be null
+     */
+    void setForceSolver(std::unique_ptr<ForceSolver> solver);
+
+    /**
+     * Returns the strategy used to compute the forces in stepSimulation
+     */
+    [[nodiscard]] ForceSolver& getForceSolver() noexcept;
+
+    /**
+     * Replaces the time stepping scheme used by stepSimulation. The Universe
+     * starts out with an EulerIntegrator.
+     * @param integrator - new integrator, must not be null
+     */
+    void setIntegrator(std::unique_ptr<Integrator> integrator);
+
+    /**
+     * Returns the time stepping scheme used by stepSimulation
+     */
+    [[nodiscard]] Integrator& getIntegrator() noexcept;
+
+    /**
+     * Sets the number of threads stepSimulation splits the force evaluation
+     * and the integration over, through a work-stealing pool. The workers are
+     * started here and kept until the next call, so steps do not create
+     * threads. One thread (the default) runs the serial code.
+     * @param threads - number of threads including the caller, must be positive
+     */
+    void setThreadCount(std::size_t threads);
+
+    /**
+     * Returns the number of threads used by stepSimulation
+     */
+    [[nodiscard]] std::size_t getThreadCount() const noexcept;
+
+    /**
+     * Returns the work-stealing pool behind the parallel step, for its
+     * counters, or null when running serially
+     */
+    [[nodiscard]] ThreadPool* getThreadPool() noexcept;
+
+    /**
+     * Makes the trajectories independent of the thread count: every sum of
+     * the step is done in an order fixed by the slots, so runs with any number
+     * of threads give the same bits. It costs a serial DirectSolver the pair
+     * symmetry, 1.3 times the time per evaluation for 4000 bodies; parallel
+     * runs and the other solvers already sum that way. Applies to the current
+     * force solver and to every solver set later.
+     * @param enabled - true for thread independent results
+     */
+    void setDeterministic(bool enabled) noexcept;
+
+    /**
+     * Returns true if the results are independent of the thread count
+     */
+    [[nodiscard]] bool getDeterministic() const noexcept;
+
+    /**
+     * Sets the mass below which bodies are test particles, which feel the
+     * gravity of the others but exert none, so the force evaluation costs
+     * O(massive * N) instead of O(N^2). Every registered body but the first is
+     * reclassified by its mass, overriding earlier per-body flags, and bodies
+     * added later become particles if flagged or lighter than the threshold.
+     * The default of 0 keeps every body massive.
+     * @param mass - threshold in kilograms, must not be negative
+     */
+    void setParticleThreshold(double mass);
+
+    /**
+     * Returns the mass below which bodies become test particles
+     */
+    [[nodiscard]] double getParticleThreshold() const noexcept;
+
+    /**
+     * Sets the perturbation ratio below which stepSimulation moves a body
+     * analytically along its Kepler orbit around the sun instead of
+     * integrating it. The ratio of a body is the pull of everything but the
+     * sun over the pull of the sun. Bodies are reclassified every
+     * KEPLER_RECHECK steps and whenever the state is changed from outside, so
+     * a comet falling in towards the planets goes back to full integration.
+     * Test particles on Kepler orbits cost no force evaluations at all, bodies
+     * that pull are integrated along for the others and then put back on their
+     * orbits. The default of 0 integrates every body.
+     * @param ratio - largest perturbation ratio of a Kepler orbit, must not be negative
+     */
+    void setKeplerRatio(double ratio);
+
+    /**
+     * Returns the perturbation ratio below which bodies follow Kepler orbits
+     */
+    [[nodiscard]] double getKeplerRatio() const noexcept;
+
+    /**
+     * Returns true if the body in the given slot was on its Kepler orbit
+     * during the last step
+     * @param slot - slot of the body in getBodies()
+     */
+    [[nodiscard]] bool isOnKepler(std::size_t slot) const noexcept;
+
+    /**
+     * Returns the number of bodies on Kepler orbits during the last step
+     */
+    [[nodiscard]] std::size_t getKeplerCount() const noexcept;
+
+    /**
+     * Sets what happens after every step to bodies closer than the sum of
+     * their radii (Object::setRadius) plus the encounter distance. The check
+     * runs a sweep and prune over the positions, linear in the number of
+     * bodies while they are well separated. In Merge mode the lighter body of
+     * a touching pair is absorbed by the heavier one: masses add up, the
+     * survivor moves to the center of mass with the total momentum and
+     * takes the combined volume. A merge with the fixed sun leaves the sun
+     * where it is. The absorbed Object is removed from the Universe, but it
+     * stays valid with its last state until the Universe is destroyed.
+     * @param mode - collision handling of later steps
+     */
+    void setCollisionMode(CollisionMode mode) noexcept;
+
+    /**
+     * Returns the collision handling of stepSimulation
+     */
+    [[nodiscard]] CollisionMode getCollisionMode() const noexcept;
+
+    /**
+     * Sets the gap between two surfaces under which a pass is recorded as a
+     * close encounter, 0 to record impacts only
+     * @param distance - gap in meters, must not be negative
+     */
+    void setEncounterDistance(double distance);
+
+    /**
+     * Returns the gap under which passes are recorded
+     */
+    [[nodiscard]] double getEncounterDistance() const noexcept;
+
+    /**
+     * Returns the impacts and encounters recorded so far, in the order they
+     * were seen
+     */
+    [[nodiscard]] const std::vector<CollisionEvent>& getCollisionEvents() const noexcept;
+
+    /**
+     * Forgets the recorded impacts and encounters
+     */
+    void clearCollisionEvents() noexcept;
+
+    /**
+     * Applies the visitor to every registered Object. In parallel mode the
+     * Objects are handed out in small tasks on the thread pool in no particular
+     * order, so the visit methods must be safe to call concurrently.
+     * @param visitor - visitor to apply
+     * @param parallel - true to spread the traversal over the thread pool
+     */
+    void accept(Visitor& visitor, bool parallel = false);
+
+    /**
+     * Advances the simulation by the provided time step with the current
+     * integrator. For this assignment, you must assume that the first
+     * registered object is a "sun" and its position should not be affected by
+     * any of the other objects. Bodies below the Kepler ratio are moved
+     * analytically (see setKeplerRatio), and touching bodies are handled at
+     * the end of the step (see setCollisionMode).
      * @param timeSec - number of seconds to step the simulation forward
      */
     void stepSimulation(const double& timeSec);
 
+    /**
+     * Advances the simulation by steps steps of dt. The integrator runs the
+     * steps between two samples as one batch in its own loop, so the per-step
+     * cost of calling stepSimulation in a loop goes away. With Kepler orbits
+     * or collision handling on, the steps are taken one by one.
+     * @param dt - number of seconds of every step
+     * @param steps - number of steps
+     * @param sampler - called after every every-th step with the time and state
+     * @param every - number of steps between two samples, must be positive
+     */
+    void advance(
+        double dt, std::size_t steps, const Sampler& sampler = {}, std::size_t every = 1);
+
+    /**
+     * Advances the simulation to the given time with steps of dt, the last
+     * step shortened to land on target
+     * @param target - simulated time to stop at, on the side dt points to
+     * @param dt - number of seconds of every step, negative to go backwards
+     * @param sampler - called after every every-th step with the time and state
+     * @param every - number of steps between two samples, must be positive
+     */
+    void advanceUntil(
+        double target, double dt, const Sampler& sampler = {}, std::size_t every = 1);
+
+    /**
+     * Returns the simulated time in seconds, the sum of every step so far
+     */
+    [[nodiscard]] double getTime() const noexcept;
+
+    /**
+     * Advances the simulation to the given time with the adaptive integrator,
+     * which picks its own steps to meet its tolerance. The state at every
+     * sample time is interpolated from the steps taken anyway, so sampling
+     * costs no extra force evaluations. Every body is integrated, whatever
+     * the Kepler ratio.
+     * @param target - simulated time to stop at, may lie in the past
+     * @param samples - times between getTime() and target, in the direction of travel
+     * @param output - called with every sample time and the state there
+     */
+    void advanceTo(double target, const std::vector<double>& samples = {},
+        const DormandPrinceIntegrator::DenseOutput& output = {});
+
     /**
      * Swaps the contents of the provided container with the Universe's Object
-     * store and releases the old Objects
+     * store and releases the old Objects. The BodyStore is rebuilt from the
+     * new Objects, which become handles onto it.
      * @param snapshot - vector of objects to swap
      */
     void swap(std::vector<Object*>& snapshot);
 
 private:
-    /**
-     * Private constructor. Ensures access control via singleton
-     */
-    Universe() = default;
-
     /**
      * Registers an Object with the universe. The Universe will clean up this
      * object when it deems necessary
@@ -96,7 +376,33 @@ private:
     Object* addObject(Object* ptr);
 
     /**
-     * Calculate the total force for the ith object in the universe
+     * Advances the bodies off their Kepler orbits with the integrator and the
+     * others analytically, then writes both back to the BodyStore
+     * @param timeSec - number of seconds to step forward
+     */
+    void stepSplit(double timeSec);
+
+    /**
+     * Sorts the bodies by their perturbation ratio into the KeplerPropagator
+     * and the store of integrated bodies
+     */
+    void split();
+
+    /**
+     * Records the encounters at the current positions and, in Merge mode,
+     * merges the touching pairs
+     */
+    void collide();
+
+    /**
+     * Merges the body in slot gone into the one in slot keep. gone is not
+     * removed yet.
+     */
+    void merge(std::size_t keep, std::size_t gone);
+
+    /**
+     * Calculate the total force for the ith object in the universe. The sum is
+     * compensated if the integrator compensates its updates.
      * @param obj object pointer within the Universe's vector of objects
      * @return Vector2 total force on object
      */
@@ -112,7 +418,32 @@ private:
     static void release(std::vector<Object*>& objects);
 
     std::vector<Object*> objects; // Container for pointers to the registered Objects
-    static Universe* inst; // Static singleton pointer
+    std::array<BodyStore, 2> frozen; // Ping-pong buffers handed out by snapshot()
+    std::array<double, 2> frozenTime {}; // Simulated time of every frozen buffer
+    std::size_t nextFrozen = 0; // Buffer the next snapshot() overwrites
+    BodyStore bodies; // Dynamic state of the registered Objects, in registration order
+    std::unique_ptr<ThreadPool> pool; // Workers of the parallel step, null when serial
+    bool deterministic = false; // Sum independently of the thread count
+    std::unique_ptr<ForceSolver> solver; // Strategy computing the accelerations of a step
+    std::unique_ptr<Integrator> integrator; // Time stepping scheme of stepSimulation
+    double time = 0.0; // Simulated seconds so far
+    double particleThreshold = 0.0; // Mass below which added bodies are test particles
+    double keplerRatio = 0.0; // Perturbation ratio below which bodies follow Kepler orbits
+    KeplerPropagator kepler; // Bodies on Kepler orbits since the last split
+    BodyStore integrated; // Bodies off Kepler orbits, and the ones that pull, since the last split
+    std::vector<std::uint32_t> integratedSlots; // Slot in bodies of every integrated body
+    std::vector<std::uint32_t> keplerSources; // Integrated slots of pulling bodies on orbits
+    std::vector<std::uint8_t> onKepler; // Whether each slot of bodies is on its orbit
+    std::vector<double> splitX; // Accelerations the last split was based on
+    std::vector<double> splitY;
+    std::uint64_t splitVersion = 0; // Version of bodies after the last split or split step
+    std::size_t stepsSinceSplit = 0; // Steps taken since the last split
+    CollisionMode collisionMode = CollisionMode::Off; // Collision handling after every step
+    CollisionDetector detector; // Sweep and prune over the positions of bodies
+    std::vector<CollisionEvent> collisionEvents; // Impacts and encounters seen so far
+    std::vector<std::uint8_t> absorbed; // Scratch flags of the slots merged away in a step
+    std::vector<Object*> merged; // Objects merged away, deleted with the Universe
+    static Universe* inst; // Process wide instance, null if none
 };
 
 #endif // UNIVERSE_H
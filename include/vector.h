@@ -5,20 +5,105 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+
+template <uint32_t DIM> class Vector;
 
 /**
  *
- *  A class representing an n-dimensional vector of doubles (n >= 1). Common
- *  vector operations are implemented in a loop-free manner to encourage use of
- *  functors, lambda expressions and STL algorithms.
+ *  Base of every vector valued expression of dimension DIM. The arithmetic
+ *  operators below do not compute anything, they return small nodes that
+ *  remember their operands and work out a single component on request. The
+ *  whole expression is then evaluated in one pass over the components when
+ *  it is assigned to a Vector or reduced with normSq(), norm() or dot(), so
+ *  pos + dt * vel or (b - a).normSq() never build an intermediate vector.
+ *
+ *  Operands that are named vectors or expressions are held by reference and
+ *  temporaries by value, so a node stays valid as long as the named operands
+ *  it was built from.
+ */
+template <uint32_t DIM, typename E> class VectorExpr {
+public:
+    static constexpr uint32_t dimension = DIM; // Number of components
+
+    /**
+     *  Returns the dot (inner) product of this expression and rhs.
+     */
+    template <typename R> double dot(const VectorExpr<DIM, R>& rhs) const
+    {
+        const E& lhs = self();
+        const R& other = static_cast<const R&>(rhs);
+        double product = 0.0;
+        for (uint32_t i = 0; i < DIM; ++i)
+            product += lhs[i] * other[i];
+        return product;
+    }
+
+    /**
+     *  Returns the square of the magnitude of this expression.
+     */
+    double normSq() const
+    {
+        // Dot product of a vector with itself yields the square of the norm.
+        return dot(*this);
+    }
+
+    /**
+     *  Returns the magnitude of this expression.
+     */
+    double norm() const
+    {
+        return std::sqrt(normSq());
+    }
+
+    /**
+     *  Returns a scaled copy of this expression such that its magnitude is 1
+     *  Throw overflow_error if norm is zero
+     */
+    Vector<DIM> normalize() const
+    {
+        const Vector<DIM> tmp(self());
+        double norm = tmp.norm();
+        if (norm == 0)
+            throw std::overflow_error("vector norm is zero");
+        return tmp / norm;
+    }
+
+    /**
+     *  Returns a human readable representation of this expression.
+     *  Ex. [1 2 3]
+     */
+    std::string toString() const
+    {
+        return Vector<DIM>(self()).toString();
+    }
+
+protected:
+    /**
+     *  Returns the expression this is the base of.
+     */
+    const E& self() const noexcept
+    {
+        return static_cast<const E&>(*this);
+    }
+};
+
+/**
+ *
+ *  A class representing an n-dimensional vector of doubles (n >= 1). It is the
+ *  leaf of the vector expressions: constructing or assigning a vector from an
+ *  expression evaluates the expression straight into its components.
  *
  *  Since no dynamic memory is used, destructor, copy constructor, and an
  *  assignment operator are not necessary.
  */
-template <uint32_t DIM> class Vector {
+template <uint32_t DIM> class Vector : public VectorExpr<DIM, Vector<DIM>> {
 public:
     /**
      *  Creates the zero vector.
@@ -41,11 +126,29 @@ public:
         std::copy_n(ptr, DIM, begin());
     }
 
+    /**
+     *  Creates a vector holding the value of expr.
+     */
+    template <typename E> Vector(const VectorExpr<DIM, E>& expr) noexcept
+    {
+        assign(static_cast<const E&>(expr));
+    }
+
     /**
      * Assignment operator - use default
      */
     Vector<DIM>& operator=(const Vector<DIM>& rhs) noexcept = default;
 
+    /**
+     *  Evaluates expr into this vector. expr may use this vector, every
+     *  component is read before it is written.
+     */
+    template <typename E> Vector<DIM>& operator=(const VectorExpr<DIM, E>& expr) noexcept
+    {
+        assign(static_cast<const E&>(expr));
+        return *this;
+    }
+
     /***************************************************************************
      *                                                                          *
      *                      S P A C E   O P E R A T I O N S                     *
@@ -57,12 +160,7 @@ public:
      */
     const Vector<DIM> add(const Vector<DIM>& rhs) const noexcept
     {
-        Vector<DIM> sum;
-        // Either the functor approach -- currently commented out -- or the lambda approach is fine
-        // std::transform(begin(), end(), rhs.begin(), sum.begin(), adder());
-        std::transform(begin(), end(), rhs.begin(), sum.begin(),
-            [](const auto& l, const auto& r) { return l + r; });
-        return sum;
+        return *this + rhs;
     }
 
     /**
@@ -70,7 +168,7 @@ public:
      */
     const Vector<DIM> invert() const
     {
-        return scale(-1.0);
+        return -*this;
     }
 
     /**
@@ -78,59 +176,7 @@ public:
      */
     const Vector<DIM> scale(double rhs) const
     {
-        Vector<DIM> s;
-        // Either the functor approach -- currently commented out -- or the lambda approach is fine
-        // Via a binder, we can reuse multiplier with a transform
-        // std::transform(begin(), end(), s.begin(), std::bind2nd(multiplier(), rhs));
-        std::transform(begin(), end(), s.begin(), [rhs](const auto& value) { return value * rhs; });
-        return s;
-    }
-
-    /**
-     *  Returns the dot (inner) product of this vector and rhs.
-     */
-    double dot(const Vector<DIM>& rhs) const
-    {
-        // transform will return the output iterator. Therefore, I hacked together
-        // an iterator that will actually accumulate the values that are "assigned
-        // to its content."
-        // return std::transform(begin(), end(), rhs.begin(), accumulator_iter(),
-        // multiplier()).accumulator;
-        double product = 0.0;
-        Vector<DIM> outVec;
-        std::transform(begin(), end(), rhs.begin(), outVec.begin(),
-            [&product](const auto& l, const auto& r) { return product += l * r; });
-        return product;
-    }
-
-    /**
-     *  Returns the square of the magnitude of this vector.
-     */
-    double normSq() const
-    {
-        // Dot product of a vector with itself yields the square of the norm.
-        return dot(*this);
-    }
-
-    /**
-     *  Returns the magnitude of this vector.
-     */
-    double norm() const
-    {
-        return std::sqrt(normSq());
-    }
-
-    /**
-     *  Returns a scaled copy of this vector such that its magnitude is 1
-     *  Throw overflow_error if norm is zero
-     */
-    Vector<DIM> normalize() const
-    {
-        Vector<DIM> tmp(*this);
-        double norm = tmp.norm();
-        if (norm == 0)
-            throw std::overflow_error("vector norm is zero");
-        return tmp / norm;
+        return *this * rhs;
     }
 
     /**
@@ -165,27 +211,6 @@ public:
      *                                                                          *
      ***************************************************************************/
 
-    /**
-     *  Returns true if this vector equals rhs.
-     */
-    bool operator==(const Vector<DIM>& rhs) const
-    {
-        // Can use either a functor or lambda
-        // return std::equal(begin(), end(), rhs.begin(), epsilonTest());
-        return std::equal(begin(), end(), rhs.begin(), [](const auto& l, const auto& r) {
-            // Absolute equality & epsilon check
-            return l == r || std::abs(r - l) < 0.0000000001;
-        });
-    }
-
-    /**
-     *  Returns true if this vector differs from rhs.
-     */
-    bool operator!=(const Vector<DIM>& rhs) const
-    {
-        return !(*this == rhs);
-    }
-
     /**
      *  Returns a reference to the index-th component of this vector. Not range
      *  checked.
@@ -204,44 +229,26 @@ public:
         return data[index];
     }
 
-    /**
-     *  Returns the sum of this vector and rhs.
-     */
-    const Vector<DIM> operator+(const Vector<DIM>& rhs) const
-    {
-        return add(rhs);
-    }
-
     /**
      *  Increments this vector by rhs and returns the result for chaining.
      */
-    Vector<DIM>& operator+=(const Vector<DIM>& rhs)
-    {
-        return *this = *this + rhs;
-    }
-
-    /**
-     *  Returns the additive inverse of this vector.
-     */
-    const Vector<DIM> operator-() const
+    template <typename E> Vector<DIM>& operator+=(const VectorExpr<DIM, E>& rhs)
     {
-        return scale(-1.0);
-    }
-
-    /**
-     *  Returns the difference between this vector and rhs.
-     */
-    const Vector<DIM> operator-(const Vector<DIM>& rhs) const
-    {
-        return *this + -rhs;
+        const E& other = static_cast<const E&>(rhs);
+        for (uint32_t i = 0; i < DIM; ++i)
+            data[i] += other[i];
+        return *this;
     }
 
     /**
      *  Decrements this vector by rhs and returns the result for chaining.
      */
-    Vector<DIM>& operator-=(const Vector<DIM>& v)
+    template <typename E> Vector<DIM>& operator-=(const VectorExpr<DIM, E>& rhs)
     {
-        return *this += -v;
+        const E& other = static_cast<const E&>(rhs);
+        for (uint32_t i = 0; i < DIM; ++i)
+            data[i] -= other[i];
+        return *this;
     }
 
     /**
@@ -249,7 +256,9 @@ public:
      */
     Vector<DIM>& operator*=(double rhs)
     {
-        return *this = scale(rhs);
+        for (double& value : data)
+            value *= rhs;
+        return *this;
     }
 
     /**
@@ -260,40 +269,16 @@ public:
         return *this *= (1.0 / rhs);
     }
 
+private:
     /**
-     *  Scales a copy of this vector by rhs and returns the result.
-     */
-    const Vector<DIM> operator*(double rhs) const
-    {
-        return scale(rhs);
-    }
-
-    /**
-     *  Scales a copy of this vector by 1.0 / rhs and returns the result.
-     */
-    const Vector<DIM> operator/(double rhs) const
-    {
-        return scale(1.0 / rhs);
-    }
-
-    /**
-     *  Returns the dot (inner) product of this vector and rhs.
+     *  Writes the components of expr, one at a time.
      */
-    double operator*(const Vector<DIM>& rhs) const
+    template <typename E> void assign(const E& expr) noexcept
     {
-        return dot(rhs);
+        for (uint32_t i = 0; i < DIM; ++i)
+            data[i] = expr[i];
     }
 
-    /**
-     *  Returns the cross product of this and rhs if called on a 3D vector.
-     *  throws an std::domain_error otherwise.
-     */
-    const Vector<DIM> operator^(const Vector<DIM>& v) const
-    {
-        return cross(v);
-    }
-
-private:
     /**
      *  Private iterator methods.
      */
@@ -327,13 +312,197 @@ typedef Vector<2UL> Vector2;
 typedef Vector<3UL> Vector3;
 typedef Vector<4UL> Vector4;
 
+namespace vector_expr {
+
+/**
+ *  True for vector expressions of any dimension, references included.
+ */
+template <typename E>
+concept Expression = requires { std::remove_cvref_t<E>::dimension; }
+    && std::is_base_of_v<VectorExpr<std::remove_cvref_t<E>::dimension, std::remove_cvref_t<E>>,
+        std::remove_cvref_t<E>>;
+
+/**
+ *  True for two vector expressions of the same dimension.
+ */
+template <typename L, typename R>
+concept Compatible = Expression<L> && Expression<R>
+    && std::remove_cvref_t<L>::dimension == std::remove_cvref_t<R>::dimension;
+
+/**
+ *  How a node holds an operand of the forwarded type T: named operands by
+ *  reference, temporaries by value.
+ */
+template <typename T>
+using Operand = std::conditional_t<std::is_lvalue_reference_v<T>,
+    const std::remove_reference_t<T>&, std::remove_cvref_t<T>>;
+
+/**
+ *  Component-wise combination of two expressions.
+ */
+template <typename L, typename R, typename Op>
+class Binary : public VectorExpr<std::remove_cvref_t<L>::dimension, Binary<L, R, Op>> {
+public:
+    Binary(L&& lhs, R&& rhs) noexcept
+        : lhs(std::forward<L>(lhs))
+        , rhs(std::forward<R>(rhs))
+    {
+    }
+
+    double operator[](uint32_t index) const
+    {
+        return Op()(lhs[index], rhs[index]);
+    }
+
+private:
+    Operand<L> lhs; // Left operand
+    Operand<R> rhs; // Right operand
+};
+
+/**
+ *  An expression multiplied by a scalar.
+ */
+template <typename E>
+class Scaled : public VectorExpr<std::remove_cvref_t<E>::dimension, Scaled<E>> {
+public:
+    Scaled(E&& expr, double factor) noexcept
+        : expr(std::forward<E>(expr))
+        , factor(factor)
+    {
+    }
+
+    double operator[](uint32_t index) const
+    {
+        return expr[index] * factor;
+    }
+
+private:
+    Operand<E> expr; // Expression being scaled
+    double factor; // Scalar every component is multiplied by
+};
+
+/**
+ *  The additive inverse of an expression.
+ */
+template <typename E>
+class Negated : public VectorExpr<std::remove_cvref_t<E>::dimension, Negated<E>> {
+public:
+    explicit Negated(E&& expr) noexcept
+        : expr(std::forward<E>(expr))
+    {
+    }
+
+    double operator[](uint32_t index) const
+    {
+        return -expr[index];
+    }
+
+private:
+    Operand<E> expr; // Expression being negated
+};
+
+} // namespace vector_expr
+
+/**
+ *  Returns the sum of lhs and rhs.
+ */
+template <typename L, typename R>
+    requires vector_expr::Compatible<L, R>
+vector_expr::Binary<L, R, std::plus<>> operator+(L&& lhs, R&& rhs) noexcept
+{
+    return { std::forward<L>(lhs), std::forward<R>(rhs) };
+}
+
+/**
+ *  Returns the difference between lhs and rhs.
+ */
+template <typename L, typename R>
+    requires vector_expr::Compatible<L, R>
+vector_expr::Binary<L, R, std::minus<>> operator-(L&& lhs, R&& rhs) noexcept
+{
+    return { std::forward<L>(lhs), std::forward<R>(rhs) };
+}
+
+/**
+ *  Returns the additive inverse of v.
+ */
+template <vector_expr::Expression E> vector_expr::Negated<E> operator-(E&& v) noexcept
+{
+    return vector_expr::Negated<E>(std::forward<E>(v));
+}
+
+/**
+ *  Returns v scaled by scale.
+ */
+template <vector_expr::Expression E>
+vector_expr::Scaled<E> operator*(E&& v, double scale) noexcept
+{
+    return { std::forward<E>(v), scale };
+}
+
+/**
+ *  Returns the result of scaling v by scale. This free function guarantees
+ *  that vector scaling is commutative.
+ */
+template <vector_expr::Expression E>
+vector_expr::Scaled<E> operator*(double scale, E&& v) noexcept
+{
+    return { std::forward<E>(v), scale };
+}
+
+/**
+ *  Returns v scaled by 1.0 / scale.
+ */
+template <vector_expr::Expression E>
+vector_expr::Scaled<E> operator/(E&& v, double scale) noexcept
+{
+    return { std::forward<E>(v), 1.0 / scale };
+}
+
+/**
+ *  Returns the dot (inner) product of lhs and rhs.
+ */
+template <uint32_t DIM, typename L, typename R>
+double operator*(const VectorExpr<DIM, L>& lhs, const VectorExpr<DIM, R>& rhs)
+{
+    return lhs.dot(rhs);
+}
+
+/**
+ *  Returns true if lhs equals rhs.
+ */
+template <uint32_t DIM, typename L, typename R>
+bool operator==(const VectorExpr<DIM, L>& lhs, const VectorExpr<DIM, R>& rhs)
+{
+    const L& left = static_cast<const L&>(lhs);
+    const R& right = static_cast<const R&>(rhs);
+    for (uint32_t i = 0; i < DIM; ++i) {
+        const double l = left[i];
+        const double r = right[i];
+        // Absolute equality & epsilon check
+        if (l != r && !(std::abs(r - l) < 0.0000000001))
+            return false;
+    }
+    return true;
+}
+
+/**
+ *  Returns true if lhs differs from rhs.
+ */
+template <uint32_t DIM, typename L, typename R>
+bool operator!=(const VectorExpr<DIM, L>& lhs, const VectorExpr<DIM, R>& rhs)
+{
+    return !(lhs == rhs);
+}
+
 /**
- *  Returns the result of scaling a copy of v by scale. This free function
- *  guarantees that vector scaling is commutative.
+ *  Returns the cross product of lhs and rhs if called on 3D vectors.
+ *  throws an std::domain_error otherwise.
  */
-template <uint32_t DIM> const Vector<DIM> operator*(double scale, const Vector<DIM>& v)
+template <uint32_t DIM, typename L, typename R>
+Vector<DIM> operator^(const VectorExpr<DIM, L>& lhs, const VectorExpr<DIM, R>& rhs)
 {
-    return v * scale;
+    return Vector<DIM>(lhs).cross(Vector<DIM>(rhs));
 }
 
 /**
@@ -0,0 +1,372 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "body_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+std::atomic<std::uint64_t> lastVersion = 0; // Last version handed out by any store
+
+} // anonymous namespace
+
+template <uint32_t DIM>
+BasicBodyStore<DIM>::BasicBodyStore(const BasicBodyStore& other)
+    : positions(other.positions)
+    , velocities(other.velocities)
+    , masses(other.masses)
+    , active(other.active)
+    , radii(other.radii)
+    , particles(other.particles)
+    , sources(other.sources)
+{
+}
+
+template <uint32_t DIM>
+BasicBodyStore<DIM>::BasicBodyStore(BasicBodyStore&& other) noexcept
+    : positions(std::move(other.positions))
+    , velocities(std::move(other.velocities))
+    , masses(std::move(other.masses))
+    , active(std::move(other.active))
+    , radii(std::move(other.radii))
+    , particles(std::move(other.particles))
+    , sources(std::move(other.sources))
+    , version(other.version)
+{
+    other.touch();
+}
+
+template <uint32_t DIM>
+BasicBodyStore<DIM>& BasicBodyStore<DIM>::operator=(const BasicBodyStore& other)
+{
+    if (this == &other)
+        return *this;
+    positions = other.positions;
+    velocities = other.velocities;
+    masses = other.masses;
+    active = other.active;
+    radii = other.radii;
+    particles = other.particles;
+    sources = other.sources;
+    touch();
+    return *this;
+}
+
+template <uint32_t DIM>
+BasicBodyStore<DIM>& BasicBodyStore<DIM>::operator=(BasicBodyStore&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+    positions = std::move(other.positions);
+    velocities = std::move(other.velocities);
+    masses = std::move(other.masses);
+    active = std::move(other.active);
+    radii = std::move(other.radii);
+    particles = std::move(other.particles);
+    sources = std::move(other.sources);
+    version = other.version;
+    other.touch();
+    return *this;
+}
+
+template <uint32_t DIM> [[nodiscard]] std::size_t BasicBodyStore<DIM>::size() const noexcept
+{
+    return masses.size();
+}
+
+template <uint32_t DIM>
+std::size_t BasicBodyStore<DIM>::add(
+    double mass, const Vector<DIM>& pos, const Vector<DIM>& vel, bool particle)
+{
+    if (particle && masses.empty())
+        throw std::logic_error("The sun in slot 0 cannot be a test particle");
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        positions[axis].push_back(pos[axis]);
+        velocities[axis].push_back(vel[axis]);
+    }
+    masses.push_back(mass);
+    active.push_back(particle ? 0.0 : mass);
+    radii.push_back(0.0);
+    particles.push_back(particle ? 1 : 0);
+    if (!particle)
+        sources.push_back(static_cast<std::uint32_t>(masses.size() - 1));
+    touch();
+    return masses.size() - 1;
+}
+
+template <uint32_t DIM> void BasicBodyStore<DIM>::remove(std::size_t slot)
+{
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        positions[axis].erase(positions[axis].begin() + slot);
+        velocities[axis].erase(velocities[axis].begin() + slot);
+    }
+    masses.erase(masses.begin() + slot);
+    active.erase(active.begin() + slot);
+    radii.erase(radii.begin() + slot);
+    particles.erase(particles.begin() + slot);
+    // The sources after the removed body move down with it
+    const auto at = std::lower_bound(sources.begin(), sources.end(), slot);
+    auto next = (at != sources.end() && *at == slot) ? sources.erase(at) : at;
+    for (; next != sources.end(); ++next)
+        --*next;
+    touch();
+}
+
+template <uint32_t DIM> void BasicBodyStore<DIM>::clear() noexcept
+{
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        positions[axis].clear();
+        velocities[axis].clear();
+    }
+    masses.clear();
+    active.clear();
+    radii.clear();
+    particles.clear();
+    sources.clear();
+    touch();
+}
+
+template <uint32_t DIM> void BasicBodyStore<DIM>::reserve(std::size_t count)
+{
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        positions[axis].reserve(count);
+        velocities[axis].reserve(count);
+    }
+    masses.reserve(count);
+    active.reserve(count);
+    radii.reserve(count);
+    particles.reserve(count);
+    sources.reserve(count);
+}
+
+template <uint32_t DIM>
+[[nodiscard]] double BasicBodyStore<DIM>::getMass(std::size_t slot) const noexcept
+{
+    return masses[slot];
+}
+
+template <uint32_t DIM> void BasicBodyStore<DIM>::setMass(std::size_t slot, double mass) noexcept
+{
+    masses[slot] = mass;
+    active[slot] = particles[slot] ? 0.0 : mass;
+    touch();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] double BasicBodyStore<DIM>::getRadius(std::size_t slot) const noexcept
+{
+    return radii[slot];
+}
+
+template <uint32_t DIM>
+void BasicBodyStore<DIM>::setRadius(std::size_t slot, double radius) noexcept
+{
+    radii[slot] = radius;
+    touch();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] Vector<DIM> BasicBodyStore<DIM>::getPosition(std::size_t slot) const noexcept
+{
+    Vector<DIM> pos;
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        pos[axis] = positions[axis][slot];
+    return pos;
+}
+
+template <uint32_t DIM>
+[[nodiscard]] Vector<DIM> BasicBodyStore<DIM>::getVelocity(std::size_t slot) const noexcept
+{
+    Vector<DIM> vel;
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        vel[axis] = velocities[axis][slot];
+    return vel;
+}
+
+template <uint32_t DIM>
+void BasicBodyStore<DIM>::setPosition(std::size_t slot, const Vector<DIM>& pos) noexcept
+{
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        positions[axis][slot] = pos[axis];
+    touch();
+}
+
+template <uint32_t DIM>
+void BasicBodyStore<DIM>::setVelocity(std::size_t slot, const Vector<DIM>& vel) noexcept
+{
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        velocities[axis][slot] = vel[axis];
+    touch();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] bool BasicBodyStore<DIM>::isParticle(std::size_t slot) const noexcept
+{
+    return particles[slot] != 0;
+}
+
+template <uint32_t DIM> void BasicBodyStore<DIM>::setParticle(std::size_t slot, bool particle)
+{
+    if (particle && slot == 0)
+        throw std::logic_error("The sun in slot 0 cannot be a test particle");
+    if (isParticle(slot) == particle)
+        return;
+    particles[slot] = particle ? 1 : 0;
+    active[slot] = particle ? 0.0 : masses[slot];
+    // The sources stay sorted by slot
+    const auto at = std::lower_bound(sources.begin(), sources.end(), slot);
+    if (particle)
+        sources.erase(at);
+    else
+        sources.insert(at, static_cast<std::uint32_t>(slot));
+    touch();
+}
+
+template <uint32_t DIM>
+void BasicBodyStore<DIM>::setParticlesBelow(double threshold, std::size_t first)
+{
+    sources.clear();
+    for (std::size_t i = 0; i < masses.size(); ++i) {
+        if (i >= first)
+            particles[i] = masses[i] < threshold ? 1 : 0;
+        active[i] = particles[i] ? 0.0 : masses[i];
+        if (!particles[i])
+            sources.push_back(static_cast<std::uint32_t>(i));
+    }
+    touch();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] const std::vector<std::uint32_t>& BasicBodyStore<DIM>::getSources() const noexcept
+{
+    return sources;
+}
+
+template <uint32_t DIM> [[nodiscard]] double* BasicBodyStore<DIM>::pos(uint32_t axis) noexcept
+{
+    return positions[axis].data();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] const double* BasicBodyStore<DIM>::pos(uint32_t axis) const noexcept
+{
+    return positions[axis].data();
+}
+
+template <uint32_t DIM> [[nodiscard]] double* BasicBodyStore<DIM>::vel(uint32_t axis) noexcept
+{
+    return velocities[axis].data();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] const double* BasicBodyStore<DIM>::vel(uint32_t axis) const noexcept
+{
+    return velocities[axis].data();
+}
+
+template <uint32_t DIM> [[nodiscard]] double* BasicBodyStore<DIM>::x() noexcept
+{
+    return pos(0);
+}
+
+template <uint32_t DIM> [[nodiscard]] const double* BasicBodyStore<DIM>::x() const noexcept
+{
+    return pos(0);
+}
+
+template <uint32_t DIM> [[nodiscard]] double* BasicBodyStore<DIM>::y() noexcept
+{
+    return pos(1);
+}
+
+template <uint32_t DIM> [[nodiscard]] const double* BasicBodyStore<DIM>::y() const noexcept
+{
+    return pos(1);
+}
+
+template <uint32_t DIM>
+[[nodiscard]] double* BasicBodyStore<DIM>::z() noexcept
+    requires(DIM >= 3)
+{
+    return pos(2);
+}
+
+template <uint32_t DIM>
+[[nodiscard]] const double* BasicBodyStore<DIM>::z() const noexcept
+    requires(DIM >= 3)
+{
+    return pos(2);
+}
+
+template <uint32_t DIM> [[nodiscard]] double* BasicBodyStore<DIM>::vx() noexcept
+{
+    return vel(0);
+}
+
+template <uint32_t DIM> [[nodiscard]] const double* BasicBodyStore<DIM>::vx() const noexcept
+{
+    return vel(0);
+}
+
+template <uint32_t DIM> [[nodiscard]] double* BasicBodyStore<DIM>::vy() noexcept
+{
+    return vel(1);
+}
+
+template <uint32_t DIM> [[nodiscard]] const double* BasicBodyStore<DIM>::vy() const noexcept
+{
+    return vel(1);
+}
+
+template <uint32_t DIM>
+[[nodiscard]] double* BasicBodyStore<DIM>::vz() noexcept
+    requires(DIM >= 3)
+{
+    return vel(2);
+}
+
+template <uint32_t DIM>
+[[nodiscard]] const double* BasicBodyStore<DIM>::vz() const noexcept
+    requires(DIM >= 3)
+{
+    return vel(2);
+}
+
+template <uint32_t DIM> [[nodiscard]] const double* BasicBodyStore<DIM>::mass() const noexcept
+{
+    return masses.data();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] const double* BasicBodyStore<DIM>::activeMass() const noexcept
+{
+    return active.data();
+}
+
+template <uint32_t DIM> [[nodiscard]] const double* BasicBodyStore<DIM>::radius() const noexcept
+{
+    return radii.data();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] std::uint64_t BasicBodyStore<DIM>::getVersion() const noexcept
+{
+    return version;
+}
+
+template <uint32_t DIM> void BasicBodyStore<DIM>::touch() noexcept
+{
+    version = nextVersion();
+}
+
+template <uint32_t DIM> std::uint64_t BasicBodyStore<DIM>::nextVersion() noexcept
+{
+    return lastVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// The planar store of the Universe and the spatial one
+template class BasicBodyStore<2>;
+template class BasicBodyStore<3>;
@@ -0,0 +1,109 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "collision_detector.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+template <uint32_t DIM> void BasicCollisionDetector<DIM>::setEncounterDistance(double distance)
+{
+    if (!(distance >= 0.0))
+        throw std::logic_error("Encounter distance must not be negative");
+    encounterDistance = distance;
+}
+
+template <uint32_t DIM>
+[[nodiscard]] double BasicCollisionDetector<DIM>::getEncounterDistance() const noexcept
+{
+    return encounterDistance;
+}
+
+template <uint32_t DIM>
+const std::vector<Encounter>& BasicCollisionDetector<DIM>::detect(
+    const BasicBodyStore<DIM>& bodies)
+{
+    const std::size_t count = bodies.size();
+    const double* x = bodies.x();
+    const double* radius = bodies.radius();
+    const double half = 0.5 * encounterDistance;
+    lower.resize(count);
+    upper.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        lower[i] = x[i] - (radius[i] + half);
+        upper[i] = x[i] + (radius[i] + half);
+    }
+    if (order.size() != count) {
+        order.resize(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+            [this](std::uint32_t a, std::uint32_t b) { return lower[a] < lower[b]; });
+    } else {
+        sort();
+    }
+
+    std::array<const double*, DIM> pos;
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        pos[axis] = bodies.pos(axis);
+    encounters.clear();
+    candidates = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        const std::uint32_t i = order[k];
+        // Only the bodies starting inside the interval of i can overlap it
+        for (std::size_t m = k + 1; m < count && lower[order[m]] <= upper[i]; ++m) {
+            const std::uint32_t j = order[m];
+            ++candidates;
+            const double touch = radius[i] + radius[j];
+            const double reach = touch + encounterDistance;
+            double disSq = 0.0;
+            for (uint32_t axis = 0; axis < DIM; ++axis) {
+                const double d = pos[axis][j] - pos[axis][i];
+                disSq += d * d;
+            }
+            if (disSq > reach * reach)
+                continue;
+            const double distance = std::sqrt(disSq);
+            encounters.push_back(
+                { std::min(i, j), std::max(i, j), distance, distance <= touch });
+        }
+    }
+    std::sort(encounters.begin(), encounters.end(), [](const Encounter& a, const Encounter& b) {
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+    return encounters;
+}
+
+template <uint32_t DIM>
+[[nodiscard]] std::size_t BasicCollisionDetector<DIM>::getCandidateCount() const noexcept
+{
+    return candidates;
+}
+
+template <uint32_t DIM> void BasicCollisionDetector<DIM>::sort()
+{
+    const std::size_t count = order.size();
+    const std::size_t limit = MAX_SHIFTS * count;
+    std::size_t shifts = 0;
+    for (std::size_t k = 1; k < count; ++k) {
+        const std::uint32_t slot = order[k];
+        const double key = lower[slot];
+        std::size_t m = k;
+        while (m > 0 && lower[order[m - 1]] > key) {
+            order[m] = order[m - 1];
+            --m;
+            if (++shifts > limit) {
+                // Too far from sorted, put slot back and start over
+                order[m] = slot;
+                std::sort(order.begin(), order.end(),
+                    [this](std::uint32_t a, std::uint32_t b) { return lower[a] < lower[b]; });
+                return;
+            }
+        }
+        order[m] = slot;
+    }
+}
+
+template class BasicCollisionDetector<2>;
+template class BasicCollisionDetector<3>;
@@ -0,0 +1,290 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "ensemble_batch.h"
+
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ENSEMBLE_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * Fills ax and ay for every body but the sun in every lane. Every lane sums its
+ * sources in slot order, exactly like a DirectSolver row
+ */
+void accelerationsScalar(const double* x, const double* y, const double* mass,
+    const std::vector<std::uint32_t>& sources, std::size_t bodies, std::size_t stride,
+    double* ax, double* ay)
+{
+    for (std::size_t i = 1; i < bodies; ++i) {
+        for (std::size_t k = 0; k < stride; ++k) {
+            const std::size_t at = i * stride + k;
+            double sumX = 0.0;
+            double sumY = 0.0;
+            for (const std::uint32_t j : sources) {
+                const double dx = x[j * stride + k] - x[at];
+                const double dy = y[j * stride + k] - y[at];
+                const double disSq = dx * dx + dy * dy;
+                // Coincident bodies (including i itself) exert no force
+                if (disSq == 0.0)
+                    continue;
+                const double scale = Universe::G / (disSq * std::sqrt(disSq));
+                sumX += mass[j] * scale * dx;
+                sumY += mass[j] * scale * dy;
+            }
+            ax[at] = sumX;
+            ay[at] = sumY;
+        }
+    }
+}
+
+#ifdef ENSEMBLE_BATCH_X86
+
+/**
+ * AVX2 version of accelerationsScalar, 4 members at a time. Same operations in
+ * the same order, so the same bits
+ */
+[[gnu::target("avx2")]] void accelerationsAvx2(const double* x, const double* y,
+    const double* mass, const std::vector<std::uint32_t>& sources, std::size_t bodies,
+    std::size_t stride, double* ax, double* ay)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d g = _mm256_set1_pd(Universe::G);
+    for (std::size_t i = 1; i < bodies; ++i) {
+        for (std::size_t k = 0; k < stride; k += 4) {
+            const std::size_t at = i * stride + k;
+            const __m256d xi = _mm256_loadu_pd(x + at);
+            const __m256d yi = _mm256_loadu_pd(y + at);
+            __m256d sumX = zero;
+            __m256d sumY = zero;
+            for (const std::uint32_t j : sources) {
+                const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + j * stride + k), xi);
+                const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + j * stride + k), yi);
+                const __m256d disSq = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+                const __m256d scale
+                    = _mm256_div_pd(g, _mm256_mul_pd(disSq, _mm256_sqrt_pd(disSq)));
+                const __m256d weight = _mm256_mul_pd(_mm256_set1_pd(mass[j]), scale);
+                // Lanes with coincident bodies keep their sum
+                const __m256d live = _mm256_cmp_pd(disSq, zero, _CMP_NEQ_OQ);
+                sumX = _mm256_blendv_pd(sumX, _mm256_add_pd(sumX, _mm256_mul_pd(weight, dx)), live);
+                sumY = _mm256_blendv_pd(sumY, _mm256_add_pd(sumY, _mm256_mul_pd(weight, dy)), live);
+            }
+            _mm256_storeu_pd(ax + at, sumX);
+            _mm256_storeu_pd(ay + at, sumY);
+        }
+    }
+}
+
+/**
+ * AVX-512 version of accelerationsScalar, 8 members at a time
+ */
+[[gnu::target("avx512f")]] void accelerationsAvx512(const double* x, const double* y,
+    const double* mass, const std::vector<std::uint32_t>& sources, std::size_t bodies,
+    std::size_t stride, double* ax, double* ay)
+{
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d g = _mm512_set1_pd(Universe::G);
+    for (std::size_t i = 1; i < bodies; ++i) {
+        for (std::size_t k = 0; k < stride; k += 8) {
+            const std::size_t at = i * stride + k;
+            const __m512d xi = _mm512_loadu_pd(x + at);
+            const __m512d yi = _mm512_loadu_pd(y + at);
+            __m512d sumX = zero;
+            __m512d sumY = zero;
+            for (const std::uint32_t j : sources) {
+                const __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x + j * stride + k), xi);
+                const __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(y + j * stride + k), yi);
+                const __m512d disSq = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy));
+                // Lanes with coincident bodies skip the division and keep their sum
+                const __mmask8 live = _mm512_cmp_pd_mask(disSq, zero, _CMP_NEQ_OQ);
+                const __m512d scale = _mm512_maskz_div_pd(
+                    live, g, _mm512_mul_pd(disSq, _mm512_maskz_sqrt_pd(live, disSq)));
+                const __m512d weight = _mm512_mul_pd(_mm512_set1_pd(mass[j]), scale);
+                sumX = _mm512_mask_add_pd(sumX, live, sumX, _mm512_mul_pd(weight, dx));
+                sumY = _mm512_mask_add_pd(sumY, live, sumY, _mm512_mul_pd(weight, dy));
+            }
+            _mm512_storeu_pd(ax + at, sumX);
+            _mm512_storeu_pd(ay + at, sumY);
+        }
+    }
+}
+
+#endif // ENSEMBLE_BATCH_X86
+
+} // anonymous namespace
+
+EnsembleBatch::EnsembleBatch(const BodyStore& system, std::size_t members)
+    : system(system)
+    , sources(system.getSources())
+    , members(members)
+    , bodies(system.size())
+    , stride((members + LANES - 1) / LANES * LANES)
+    , level(SimdSolver::detect())
+{
+    if (members == 0)
+        throw std::logic_error("Ensemble must have at least one member");
+    // Empty lanes keep every body at the origin, where nothing pulls
+    const std::size_t size = bodies * stride;
+    x.assign(size, 0.0);
+    y.assign(size, 0.0);
+    vx.assign(size, 0.0);
+    vy.assign(size, 0.0);
+    ax.assign(size, 0.0);
+    ay.assign(size, 0.0);
+    for (std::size_t slot = 0; slot < bodies; ++slot) {
+        std::fill_n(x.begin() + slot * stride, members, system.x()[slot]);
+        std::fill_n(y.begin() + slot * stride, members, system.y()[slot]);
+        std::fill_n(vx.begin() + slot * stride, members, system.vx()[slot]);
+        std::fill_n(vy.begin() + slot * stride, members, system.vy()[slot]);
+    }
+}
+
+[[nodiscard]] std::size_t EnsembleBatch::getMemberCount() const noexcept
+{
+    return members;
+}
+
+[[nodiscard]] std::size_t EnsembleBatch::getBodyCount() const noexcept
+{
+    return bodies;
+}
+
+void EnsembleBatch::setLevel(SimdLevel level) noexcept
+{
+    this->level = std::min(level, SimdSolver::detect());
+}
+
+[[nodiscard]] SimdLevel EnsembleBatch::getLevel() const noexcept
+{
+    return level;
+}
+
+void EnsembleBatch::setPosition(std::size_t member, std::size_t slot, const Vector2& pos)
+{
+    const std::size_t at = index(member, slot);
+    x[at] = pos[0];
+    y[at] = pos[1];
+    fresh = false;
+}
+
+void EnsembleBatch::setVelocity(std::size_t member, std::size_t slot, const Vector2& vel)
+{
+    const std::size_t at = index(member, slot);
+    vx[at] = vel[0];
+    vy[at] = vel[1];
+}
+
+[[nodiscard]] Vector2 EnsembleBatch::getPosition(std::size_t member, std::size_t slot) const
+{
+    const std::size_t at = index(member, slot);
+    Vector2 pos;
+    pos[0] = x[at];
+    pos[1] = y[at];
+    return pos;
+}
+
+[[nodiscard]] Vector2 EnsembleBatch::getVelocity(std::size_t member, std::size_t slot) const
+{
+    const std::size_t at = index(member, slot);
+    Vector2 vel;
+    vel[0] = vx[at];
+    vel[1] = vy[at];
+    return vel;
+}
+
+[[nodiscard]] BodyStore EnsembleBatch::getMember(std::size_t member) const
+{
+    BodyStore state = system;
+    for (std::size_t slot = 0; slot < bodies; ++slot) {
+        state.setPosition(slot, getPosition(member, slot));
+        state.setVelocity(slot, getVelocity(member, slot));
+    }
+    return state;
+}
+
+void EnsembleBatch::step(double dt)
+{
+    time += dt;
+    if (bodies < 2)
+        return;
+    if (!fresh)
+        evaluate();
+    kick(0.5 * dt);
+    drift(dt);
+    evaluate();
+    kick(0.5 * dt);
+}
+
+void EnsembleBatch::advance(double dt, std::size_t steps)
+{
+    const double start = time;
+    time = start + static_cast<double>(steps) * dt;
+    if (bodies < 2 || steps == 0)
+        return;
+    if (!fresh)
+        evaluate();
+    double pending = 0.5 * dt;
+    for (std::size_t n = 0; n < steps; ++n) {
+        kick(pending);
+        drift(dt);
+        evaluate();
+        pending = dt;
+    }
+    kick(0.5 * dt);
+}
+
+[[nodiscard]] double EnsembleBatch::getTime() const noexcept
+{
+    return time;
+}
+
+[[nodiscard]] std::size_t EnsembleBatch::index(std::size_t member, std::size_t slot) const
+{
+    if (member >= members || slot >= bodies)
+        throw std::logic_error("Ensemble member or slot out of range");
+    return slot * stride + member;
+}
+
+void EnsembleBatch::evaluate()
+{
+    const double* mass = system.activeMass();
+#ifdef ENSEMBLE_BATCH_X86
+    if (level == SimdLevel::Avx512) {
+        accelerationsAvx512(
+            x.data(), y.data(), mass, sources, bodies, stride, ax.data(), ay.data());
+        fresh = true;
+        return;
+    }
+    if (level == SimdLevel::Avx2) {
+        accelerationsAvx2(x.data(), y.data(), mass, sources, bodies, stride, ax.data(), ay.data());
+        fresh = true;
+        return;
+    }
+#endif
+    accelerationsScalar(x.data(), y.data(), mass, sources, bodies, stride, ax.data(), ay.data());
+    fresh = true;
+}
+
+void EnsembleBatch::kick(double dt)
+{
+    // The sun in the first row has no acceleration
+    for (std::size_t at = 0; at < bodies * stride; ++at) {
+        vx[at] += dt * ax[at];
+        vy[at] += dt * ay[at];
+    }
+}
+
+void EnsembleBatch::drift(double dt)
+{
+    for (std::size_t at = 0; at < bodies * stride; ++at) {
+        x[at] += dt * vx[at];
+        y[at] += dt * vy[at];
+    }
+}
@@ -0,0 +1,54 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "ensemble_runner.h"
+
+#include "universe.h"
+
+#include <exception>
+#include <stdexcept>
+
+EnsembleRunner::EnsembleRunner(std::size_t threads)
+{
+    if (threads == 0)
+        throw std::logic_error("Thread count must be positive");
+    if (threads > 1)
+        pool = std::make_unique<ThreadPool>(threads);
+}
+
+[[nodiscard]] std::size_t EnsembleRunner::getThreadCount() const noexcept
+{
+    return pool ? pool->getWorkerCount() : 1;
+}
+
+std::vector<EnsembleMember> EnsembleRunner::run(std::size_t members, const Setup& setup,
+    double dt, std::size_t steps, const Collect& collect)
+{
+    std::vector<EnsembleMember> results(members);
+    auto runMember = [&](std::size_t index) {
+        EnsembleMember& result = results[index];
+        result.index = index;
+        try {
+            Universe universe;
+            setup(universe, index);
+            universe.advance(dt, steps);
+            result.time = universe.getTime();
+            result.state = universe.getBodies();
+            if (collect)
+                collect(universe, index);
+        } catch (const std::exception& error) {
+            result.error = error.what();
+        }
+    };
+
+    if (!pool) {
+        for (std::size_t index = 0; index < members; ++index)
+            runMember(index);
+        return results;
+    }
+    // One task per member, parallelFor would batch them by the chunk alignment
+    ThreadPool::TaskGroup group(*pool);
+    for (std::size_t index = 0; index < members; ++index)
+        group.run([&runMember, index] { runMember(index); });
+    group.wait();
+    return results;
+}
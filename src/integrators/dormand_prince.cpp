@@ -0,0 +1,269 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/dormand_prince.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t STAGES = DormandPrinceIntegrator::STAGES;
+
+// Butcher tableau, row s holds the weights of the earlier stages for stage s.
+// The last row is also the fifth order solution.
+constexpr double A[STAGES][STAGES - 1] = {
+    {},
+    { 1.0 / 5.0 },
+    { 3.0 / 40.0, 9.0 / 40.0 },
+    { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0 },
+    { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0 },
+    { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0 },
+    { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 },
+};
+
+// Fifth minus fourth order weights, the local error estimate
+constexpr double E[STAGES] = { 71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0,
+    -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0 };
+
+// Weights of the fourth degree term of the continuous extension
+constexpr double D[STAGES] = { -12715105075.0 / 11282082432.0, 0.0,
+    87487479700.0 / 32700410799.0, -10690763975.0 / 1880347072.0,
+    701980252875.0 / 199316789632.0, -1453857185.0 / 822651844.0, 69997945.0 / 29380423.0 };
+
+constexpr double SAFETY = 0.9; // Fraction of the optimal step actually taken
+constexpr double MIN_FACTOR = 0.2; // Largest shrink of the step at once
+constexpr double MAX_FACTOR = 5.0; // Largest growth of the step at once
+
+/**
+ * Returns the factor to scale a step by after it scored error
+ */
+double stepFactor(double error)
+{
+    if (error == 0.0)
+        return MAX_FACTOR;
+    if (!std::isfinite(error))
+        return MIN_FACTOR;
+    return std::clamp(SAFETY * std::pow(error, -0.2), MIN_FACTOR, MAX_FACTOR);
+}
+
+/**
+ * Continuous extension of one component at theta in [0, 1] of a step of
+ * length h from start to end
+ * @param first - derivative at the start
+ * @param last - derivative at the end
+ * @param quartic - D weighted sum of the stage derivatives
+ */
+double extend(double start, double end, double first, double last, double quartic, double h,
+    double theta)
+{
+    const double change = end - start;
+    const double third = h * first - change;
+    const double fourth = change - h * last - third;
+    const double inner = third + theta * (fourth + (1.0 - theta) * h * quartic);
+    return start + theta * (change + (1.0 - theta) * inner);
+}
+
+} // anonymous namespace
+
+DormandPrinceIntegrator::DormandPrinceIntegrator(double tolerance)
+    : tolerance(tolerance)
+{
+    if (!(tolerance > 0.0))
+        throw std::logic_error("Dormand-Prince tolerance must be positive");
+}
+
+[[nodiscard]] double DormandPrinceIntegrator::getTolerance() const noexcept
+{
+    return tolerance;
+}
+
+[[nodiscard]] double DormandPrinceIntegrator::getStepSize() const noexcept
+{
+    return stepSize;
+}
+
+[[nodiscard]] std::size_t DormandPrinceIntegrator::getAcceptedSteps() const noexcept
+{
+    return accepted;
+}
+
+[[nodiscard]] std::size_t DormandPrinceIntegrator::getRejectedSteps() const noexcept
+{
+    return rejected;
+}
+
+void DormandPrinceIntegrator::step(BodyStore& bodies, ForceSolver& solver, double dt)
+{
+    advanceDense(bodies, solver, dt, {}, {});
+}
+
+void DormandPrinceIntegrator::advanceDense(BodyStore& bodies, ForceSolver& solver, double dt,
+    const std::vector<double>& times, const DenseOutput& output)
+{
+    const std::size_t count = bodies.size();
+    const double direction = dt < 0.0 ? -1.0 : 1.0;
+    const double total = std::abs(dt);
+    for (std::size_t k = 0; k < times.size(); ++k) {
+        const double offset = direction * times[k];
+        if (offset < 0.0 || offset > total || (k > 0 && offset < direction * times[k - 1]))
+            throw std::logic_error("Output times must be ordered and inside the step");
+    }
+    if (count < 2 || dt == 0.0) {
+        for (const double time : times)
+            output(time, bodies);
+        return;
+    }
+
+    startX.resize(count);
+    startY.resize(count);
+    startVx.resize(count);
+    startVy.resize(count);
+    for (Stage& stage : stages) {
+        stage.vx.assign(count, 0.0);
+        stage.vy.assign(count, 0.0);
+        stage.ax.assign(count, 0.0);
+        stage.ay.assign(count, 0.0);
+    }
+
+    double wanted = stepSize > 0.0 ? stepSize : total;
+    double done = 0.0;
+    std::size_t next = 0;
+    while (done < total) {
+        // The first stage is the last one of the previous step, usually cached
+        updateAccelerations(bodies, solver);
+        std::copy_n(bodies.x(), count, startX.begin());
+        std::copy_n(bodies.y(), count, startY.begin());
+        std::copy_n(bodies.vx(), count, startVx.begin());
+        std::copy_n(bodies.vy(), count, startVy.begin());
+        std::copy_n(bodies.vx() + 1, count - 1, stages[0].vx.begin() + 1);
+        std::copy_n(bodies.vy() + 1, count - 1, stages[0].vy.begin() + 1);
+        std::copy_n(acc[0].begin() + 1, count - 1, stages[0].ax.begin() + 1);
+        std::copy_n(acc[1].begin() + 1, count - 1, stages[0].ay.begin() + 1);
+
+        bool retried = false;
+        double length = 0.0;
+        while (true) {
+            const bool last = wanted >= total - done;
+            length = last ? total - done : wanted;
+            if (length <= total * std::numeric_limits<double>::epsilon())
+                throw std::logic_error("Dormand-Prince step size underflow");
+            const double error = attempt(bodies, solver, direction * length);
+            if (error <= 1.0) {
+                double factor = stepFactor(error);
+                if (retried)
+                    factor = std::min(factor, 1.0);
+                // A step shortened to hit the end says little about the next one
+                wanted = last ? std::max(wanted, length * factor) : length * factor;
+                ++accepted;
+                break;
+            }
+            wanted = length * stepFactor(error);
+            retried = true;
+            ++rejected;
+        }
+
+        // The positions are already at the new state, the last stage holds the velocities
+        std::copy_n(stages[STAGES - 1].vx.begin() + 1, count - 1, bodies.vx() + 1);
+        std::copy_n(stages[STAGES - 1].vy.begin() + 1, count - 1, bodies.vy() + 1);
+        while (next < times.size() && direction * times[next] <= done + length) {
+            interpolate(bodies, direction * length, (direction * times[next] - done) / length);
+            output(times[next], dense);
+            ++next;
+        }
+        done = length >= total - done ? total : done + length;
+    }
+    stepSize = wanted;
+}
+
+double DormandPrinceIntegrator::attempt(BodyStore& bodies, ForceSolver& solver, double h)
+{
+    const std::size_t count = bodies.size();
+    double* x = bodies.x();
+    double* y = bodies.y();
+    for (std::size_t s = 1; s < STAGES; ++s) {
+        Stage& stage = stages[s];
+        forEachBody(count, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                double dx = 0.0;
+                double dy = 0.0;
+                double dvx = 0.0;
+                double dvy = 0.0;
+                for (std::size_t j = 0; j < s; ++j) {
+                    dx += A[s][j] * stages[j].vx[i];
+                    dy += A[s][j] * stages[j].vy[i];
+                    dvx += A[s][j] * stages[j].ax[i];
+                    dvy += A[s][j] * stages[j].ay[i];
+                }
+                x[i] = startX[i] + h * dx;
+                y[i] = startY[i] + h * dy;
+                stage.vx[i] = startVx[i] + h * dvx;
+                stage.vy[i] = startVy[i] + h * dvy;
+            }
+        });
+        bodies.touch();
+        updateAccelerations(bodies, solver);
+        std::copy_n(acc[0].begin() + 1, count - 1, stage.ax.begin() + 1);
+        std::copy_n(acc[1].begin() + 1, count - 1, stage.ay.begin() + 1);
+    }
+
+    // Compare every body against the size of its own position and velocity
+    const Stage& end = stages[STAGES - 1];
+    double worst = 0.0;
+    for (std::size_t i = 1; i < count; ++i) {
+        double ex = 0.0;
+        double ey = 0.0;
+        double evx = 0.0;
+        double evy = 0.0;
+        for (std::size_t j = 0; j < STAGES; ++j) {
+            ex += E[j] * stages[j].vx[i];
+            ey += E[j] * stages[j].vy[i];
+            evx += E[j] * stages[j].ax[i];
+            evy += E[j] * stages[j].ay[i];
+        }
+        const double position = std::max(std::hypot(startX[i], startY[i]), std::hypot(x[i], y[i]));
+        const double velocity
+            = std::max(std::hypot(startVx[i], startVy[i]), std::hypot(end.vx[i], end.vy[i]));
+        const double positionError = std::abs(h) * std::hypot(ex, ey);
+        const double velocityError = std::abs(h) * std::hypot(evx, evy);
+        double error = 0.0;
+        if (positionError > 0.0)
+            error = positionError / (tolerance * position);
+        if (velocityError > 0.0)
+            error = std::max(error, velocityError / (tolerance * velocity));
+        if (std::isnan(error))
+            return std::numeric_limits<double>::infinity();
+        worst = std::max(worst, error);
+    }
+    return worst;
+}
+
+void DormandPrinceIntegrator::interpolate(const BodyStore& bodies, double h, double theta)
+{
+    const std::size_t count = bodies.size();
+    dense = bodies;
+    double* x = dense.x();
+    double* y = dense.y();
+    double* vx = dense.vx();
+    double* vy = dense.vy();
+    const Stage& first = stages[0];
+    const Stage& last = stages[STAGES - 1];
+    for (std::size_t i = 1; i < count; ++i) {
+        double qx = 0.0;
+        double qy = 0.0;
+        double qvx = 0.0;
+        double qvy = 0.0;
+        for (std::size_t j = 0; j < STAGES; ++j) {
+            qx += D[j] * stages[j].vx[i];
+            qy += D[j] * stages[j].vy[i];
+            qvx += D[j] * stages[j].ax[i];
+            qvy += D[j] * stages[j].ay[i];
+        }
+        x[i] = extend(startX[i], x[i], first.vx[i], last.vx[i], qx, h, theta);
+        y[i] = extend(startY[i], y[i], first.vy[i], last.vy[i], qy, h, theta);
+        vx[i] = extend(startVx[i], vx[i], first.ax[i], last.ax[i], qvx, h, theta);
+        vy[i] = extend(startVy[i], vy[i], first.ay[i], last.ay[i], qvy, h, theta);
+    }
+    dense.touch();
+}
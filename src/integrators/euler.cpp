@@ -0,0 +1,66 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/euler.h"
+
+#include "body_store.h"
+
+template <uint32_t DIM>
+void BasicEulerIntegrator<DIM>::step(
+    BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt)
+{
+    if (bodies.size() < 2)
+        return;
+
+    // Accelerations first, so every body sees the state at the start of the step
+    this->updateAccelerations(bodies, solver);
+    this->prepareCompensation(bodies);
+    update(bodies, dt);
+    bodies.touch();
+    this->keepCompensation(bodies);
+}
+
+template <uint32_t DIM>
+void BasicEulerIntegrator<DIM>::advance(
+    BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt, std::size_t steps)
+{
+    if (bodies.size() < 2)
+        return;
+
+    // Nobody looks at the version inside the batch, so the evaluations skip the cache
+    this->prepareCompensation(bodies);
+    for (std::size_t n = 0; n < steps; ++n) {
+        this->evaluateAccelerations(bodies, solver);
+        update(bodies, dt);
+    }
+    bodies.touch();
+    this->keepCompensation(bodies);
+}
+
+template <uint32_t DIM>
+void BasicEulerIntegrator<DIM>::update(BasicBodyStore<DIM>& bodies, double dt)
+{
+    const bool compensated = this->getCompensation();
+    this->forEachBody(bodies.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (uint32_t axis = 0; axis < DIM; ++axis) {
+            double* x = bodies.pos(axis);
+            double* v = bodies.vel(axis);
+            const double* a = this->acc[axis].data();
+            if (compensated) {
+                double* xCarry = this->posCarry[axis].data();
+                double* vCarry = this->velCarry[axis].data();
+                for (std::size_t i = begin; i < end; ++i) {
+                    this->compensatedAdd(x[i], xCarry[i], dt * v[i]);
+                    this->compensatedAdd(v[i], vCarry[i], dt * a[i]);
+                }
+                continue;
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                x[i] += dt * v[i];
+                v[i] += dt * a[i];
+            }
+        }
+    });
+}
+
+template class BasicEulerIntegrator<2>;
+template class BasicEulerIntegrator<3>;
@@ -0,0 +1,243 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/hermite.h"
+
+#include "body_store.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr double ETA_START = 0.01; // Coefficient of the first step, |a| / |j| scaled
+
+/**
+ * Returns the block step dt / 2^level
+ */
+double stepOf(double dt, std::uint32_t level)
+{
+    return std::ldexp(dt, -static_cast<int>(level));
+}
+
+/**
+ * One component of a corrected body and the derivatives at the new time
+ */
+struct Corrected {
+    double pos; // Corrected position
+    double vel; // Corrected velocity
+    double snap; // Second derivative of the acceleration
+    double crackle; // Third derivative of the acceleration
+};
+
+/**
+ * Hermite corrector for one component, from the acceleration and jerk at both
+ * ends of a step of length h
+ */
+Corrected correct(double pos, double vel, double a0, double j0, double a1, double j1, double h)
+{
+    const double vel1 = vel + 0.5 * h * (a0 + a1) + h * h * (j0 - j1) / 12.0;
+    const double pos1 = pos + 0.5 * h * (vel + vel1) + h * h * (a0 - a1) / 12.0;
+    const double crackle = (12.0 * (a0 - a1) + 6.0 * h * (j0 + j1)) / (h * h * h);
+    const double snap = (-6.0 * (a0 - a1) - h * (4.0 * j0 + 2.0 * j1)) / (h * h) + h * crackle;
+    return { pos1, vel1, snap, crackle };
+}
+
+} // anonymous namespace
+
+HermiteIntegrator::HermiteIntegrator(double eta)
+    : eta(eta)
+{
+    if (!(eta > 0.0 && eta < 1.0))
+        throw std::logic_error("Hermite accuracy parameter must be between 0 and 1");
+}
+
+[[nodiscard]] double HermiteIntegrator::getEta() const noexcept
+{
+    return eta;
+}
+
+[[nodiscard]] double HermiteIntegrator::getTimeStep(std::size_t slot) const noexcept
+{
+    return slot < stepSeconds.size() ? stepSeconds[slot] : 0.0;
+}
+
+[[nodiscard]] std::uint64_t HermiteIntegrator::getBodyEvaluations() const noexcept
+{
+    return bodyEvaluations;
+}
+
+[[nodiscard]] std::uint64_t HermiteIntegrator::getBlockCount() const noexcept
+{
+    return blocks;
+}
+
+void HermiteIntegrator::step(BodyStore& bodies, ForceSolver&, double dt)
+{
+    const std::size_t count = bodies.size();
+    if (count < 2 || dt == 0.0)
+        return;
+    start(bodies, dt);
+
+    double* x = bodies.x();
+    double* y = bodies.y();
+    double* vx = bodies.vx();
+    double* vy = bodies.vy();
+    const double tick = stepOf(dt, MAX_LEVEL);
+    const std::uint64_t end = std::uint64_t { 1 } << MAX_LEVEL;
+
+    std::uint64_t now = 0;
+    while (now < end) {
+        // The next block time is the earliest time a body is due
+        now = end;
+        for (std::size_t i = 1; i < count; ++i)
+            now = std::min(now, time[i] + (std::uint64_t { 1 } << (MAX_LEVEL - level[i])));
+        active.clear();
+        for (std::size_t i = 1; i < count; ++i) {
+            if (time[i] + (std::uint64_t { 1 } << (MAX_LEVEL - level[i])) == now)
+                active.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        // Predict everyone to the block time, the sun stays where it is
+        for (std::size_t i = 1; i < count; ++i) {
+            const double h = static_cast<double>(now - time[i]) * tick;
+            predX[i] = x[i] + h * (vx[i] + h * (0.5 * acc[0][i] + h * jerkX[i] / 6.0));
+            predY[i] = y[i] + h * (vy[i] + h * (0.5 * acc[1][i] + h * jerkY[i] / 6.0));
+            predVx[i] = vx[i] + h * (acc[0][i] + 0.5 * h * jerkX[i]);
+            predVy[i] = vy[i] + h * (acc[1][i] + 0.5 * h * jerkY[i]);
+        }
+        evaluate(bodies);
+
+        for (std::size_t k = 0; k < active.size(); ++k) {
+            const std::uint32_t i = active[k];
+            const double h = static_cast<double>(now - time[i]) * tick;
+
+            const Corrected cx = correct(x[i], vx[i], acc[0][i], jerkX[i], newAx[k], newJx[k], h);
+            const Corrected cy = correct(y[i], vy[i], acc[1][i], jerkY[i], newAy[k], newJy[k], h);
+            x[i] = cx.pos;
+            y[i] = cy.pos;
+            vx[i] = cx.vel;
+            vy[i] = cy.vel;
+            acc[0][i] = newAx[k];
+            acc[1][i] = newAy[k];
+            jerkX[i] = newJx[k];
+            jerkY[i] = newJy[k];
+            time[i] = now;
+
+            // Aarseth's criterion, then the closest block step that keeps alignment
+            const double accel = std::hypot(acc[0][i], acc[1][i]);
+            const double jerk = std::hypot(jerkX[i], jerkY[i]);
+            const double snap = std::hypot(cx.snap, cy.snap);
+            const double crackle = std::hypot(cx.crackle, cy.crackle);
+            const double denominator = jerk * crackle + snap * snap;
+            const double wanted = denominator > 0.0
+                ? std::sqrt(eta * (accel * snap + jerk * jerk) / denominator)
+                : std::numeric_limits<double>::infinity();
+            const std::uint64_t span = std::uint64_t { 1 } << (MAX_LEVEL - level[i]);
+            if (wanted < std::abs(h)) {
+                while (level[i] < MAX_LEVEL && std::abs(stepOf(dt, level[i])) > wanted)
+                    ++level[i];
+            } else if (wanted > 2.0 * std::abs(h) && level[i] > 0 && now % (2 * span) == 0) {
+                --level[i];
+            }
+            stepSeconds[i] = std::abs(stepOf(dt, level[i]));
+        }
+        bodyEvaluations += active.size();
+        ++blocks;
+    }
+
+    bodies.touch();
+    cachedVersion = bodies.getVersion();
+}
+
+void HermiteIntegrator::start(const BodyStore& bodies, double dt)
+{
+    const std::size_t count = bodies.size();
+    if (cachedVersion != bodies.getVersion() || level.size() != count) {
+        // Fresh accelerations and jerks for everyone, steps from scratch
+        level.assign(count, 0);
+        time.assign(count, 0);
+        stepSeconds.assign(count, 0.0);
+        acc[0].assign(count, 0.0);
+        acc[1].assign(count, 0.0);
+        jerkX.assign(count, 0.0);
+        jerkY.assign(count, 0.0);
+        predX.assign(bodies.x(), bodies.x() + count);
+        predY.assign(bodies.y(), bodies.y() + count);
+        predVx.assign(bodies.vx(), bodies.vx() + count);
+        predVy.assign(bodies.vy(), bodies.vy() + count);
+        active.clear();
+        for (std::size_t i = 1; i < count; ++i)
+            active.push_back(static_cast<std::uint32_t>(i));
+        predVx[0] = 0.0;
+        predVy[0] = 0.0;
+        evaluate(bodies);
+        for (std::size_t k = 0; k < active.size(); ++k) {
+            const std::uint32_t i = active[k];
+            acc[0][i] = newAx[k];
+            acc[1][i] = newAy[k];
+            jerkX[i] = newJx[k];
+            jerkY[i] = newJy[k];
+            const double jerk = std::hypot(jerkX[i], jerkY[i]);
+            stepSeconds[i]
+                = jerk > 0.0 ? ETA_START * std::hypot(acc[0][i], acc[1][i]) / jerk : std::abs(dt);
+        }
+        bodyEvaluations += active.size();
+    }
+
+    // Largest block step of the new dt that does not exceed the body's step
+    for (std::size_t i = 1; i < count; ++i) {
+        level[i] = 0;
+        while (level[i] < MAX_LEVEL && std::abs(stepOf(dt, level[i])) > stepSeconds[i])
+            ++level[i];
+        time[i] = 0;
+    }
+    predX[0] = bodies.x()[0];
+    predY[0] = bodies.y()[0];
+}
+
+void HermiteIntegrator::evaluate(const BodyStore& bodies)
+{
+    const std::vector<std::uint32_t>& sources = bodies.getSources();
+    const double* mass = bodies.activeMass();
+    newAx.resize(active.size());
+    newAy.resize(active.size());
+    newJx.resize(active.size());
+    newJy.resize(active.size());
+
+    auto sum = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t k = begin; k < end; ++k) {
+            const std::uint32_t i = active[k];
+            double ax = 0.0;
+            double ay = 0.0;
+            double jx = 0.0;
+            double jy = 0.0;
+            for (const std::uint32_t j : sources) {
+                const double dx = predX[j] - predX[i];
+                const double dy = predY[j] - predY[i];
+                const double disSq = dx * dx + dy * dy;
+                // Coincident bodies (including i itself) exert no force
+                if (disSq == 0.0)
+                    continue;
+                const double dvx = predVx[j] - predVx[i];
+                const double dvy = predVy[j] - predVy[i];
+                const double scale = Universe::G * mass[j] / (disSq * std::sqrt(disSq));
+                const double radial = 3.0 * (dx * dvx + dy * dvy) / disSq;
+                ax += scale * dx;
+                ay += scale * dy;
+                jx += scale * (dvx - radial * dx);
+                jy += scale * (dvy - radial * dy);
+            }
+            newAx[k] = ax;
+            newAy[k] = ay;
+            newJx[k] = jx;
+            newJy[k] = jy;
+        }
+    };
+    if (getThreadPool())
+        getThreadPool()->parallelFor(active.size(), sum);
+    else
+        sum(0, active.size(), 0);
+}
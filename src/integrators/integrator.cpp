@@ -0,0 +1,109 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/integrator.h"
+
+#include "body_store.h"
+#include "solvers/force_solver.h"
+
+template <uint32_t DIM>
+void BasicIntegrator<DIM>::advance(
+    BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt, std::size_t steps)
+{
+    for (std::size_t n = 0; n < steps; ++n)
+        step(bodies, solver, dt);
+}
+
+template <uint32_t DIM> void BasicIntegrator<DIM>::setThreadPool(ThreadPool* pool) noexcept
+{
+    this->pool = pool;
+}
+
+template <uint32_t DIM>
+[[nodiscard]] ThreadPool* BasicIntegrator<DIM>::getThreadPool() const noexcept
+{
+    return pool;
+}
+
+template <uint32_t DIM>
+[[nodiscard]] std::size_t BasicIntegrator<DIM>::getForceEvaluations() const noexcept
+{
+    return evaluations;
+}
+
+template <uint32_t DIM> void BasicIntegrator<DIM>::setCompensation(bool enabled) noexcept
+{
+    compensation = enabled;
+    carryVersion = 0;
+}
+
+template <uint32_t DIM> [[nodiscard]] bool BasicIntegrator<DIM>::getCompensation() const noexcept
+{
+    return compensation;
+}
+
+template <uint32_t DIM>
+void BasicIntegrator<DIM>::prepareCompensation(const BasicBodyStore<DIM>& bodies)
+{
+    if (!compensation)
+        return;
+    const std::size_t count = bodies.size();
+    if (carryVersion == bodies.getVersion() && posCarry[0].size() == count)
+        return;
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        posCarry[axis].assign(count, 0.0);
+        velCarry[axis].assign(count, 0.0);
+    }
+}
+
+template <uint32_t DIM>
+void BasicIntegrator<DIM>::keepCompensation(const BasicBodyStore<DIM>& bodies) noexcept
+{
+    if (compensation)
+        carryVersion = bodies.getVersion();
+}
+
+template <uint32_t DIM>
+void BasicIntegrator<DIM>::updateAccelerations(
+    const BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver)
+{
+    if (cachedSolver == &solver && cachedGeneration == solver.getGeneration()
+        && cachedVersion == bodies.getVersion() && acc[0].size() == bodies.size())
+        return;
+    evaluate(bodies, solver);
+    keepAccelerations(bodies, solver);
+}
+
+template <uint32_t DIM>
+void BasicIntegrator<DIM>::evaluateAccelerations(
+    const BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver)
+{
+    evaluate(bodies, solver);
+    // Stale until keepAccelerations ties them to a version
+    cachedSolver = nullptr;
+    cachedVersion = 0;
+}
+
+template <uint32_t DIM>
+void BasicIntegrator<DIM>::keepAccelerations(
+    const BasicBodyStore<DIM>& bodies, const BasicForceSolver<DIM>& solver) noexcept
+{
+    cachedSolver = &solver;
+    cachedGeneration = solver.getGeneration();
+    cachedVersion = bodies.getVersion();
+}
+
+template <uint32_t DIM>
+void BasicIntegrator<DIM>::evaluate(
+    const BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver)
+{
+    typename BasicForceSolver<DIM>::Axes out;
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        acc[axis].resize(bodies.size());
+        out[axis] = acc[axis].data();
+    }
+    solver.computeAccelerations(bodies, out);
+    ++evaluations;
+}
+
+template class BasicIntegrator<2>;
+template class BasicIntegrator<3>;
@@ -0,0 +1,115 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/kepler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace {
+
+constexpr int MAX_ITERATIONS = 50; // Laguerre-Conway iterations before giving up on a block
+constexpr double SERIES_LIMIT = 1e-2; // |z| below which the Stumpff series is used
+
+/**
+ * Stumpff functions c2(z) = (1 - cos sqrt(z)) / z and
+ * c3(z) = (sqrt(z) - sin sqrt(z)) / z^(3/2), continued to z <= 0
+ */
+void stumpff(double z, double& c2, double& c3)
+{
+    if (std::abs(z) < SERIES_LIMIT) {
+        c2 = 1.0 / 2 - z * (1.0 / 24 - z * (1.0 / 720 - z * (1.0 / 40320 - z / 3628800)));
+        c3 = 1.0 / 6 - z * (1.0 / 120 - z * (1.0 / 5040 - z * (1.0 / 362880 - z / 39916800)));
+    } else if (z > 0.0) {
+        const double root = std::sqrt(z);
+        const double half = std::sin(0.5 * root);
+        c2 = 2.0 * half * half / z;
+        c3 = (root - std::sin(root)) / (z * root);
+    } else {
+        const double root = std::sqrt(-z);
+        c2 = (std::cosh(root) - 1.0) / -z;
+        c3 = (std::sinh(root) - root) / (-z * root);
+    }
+}
+
+} // anonymous namespace
+
+void keplerDrift(double mu, double centerX, double centerY, double dt, std::size_t begin,
+    std::size_t end, double* x, double* y, double* vx, double* vy)
+{
+    const double sqrtMu = std::sqrt(mu);
+    for (std::size_t base = begin; base < end; base += KEPLER_LANES) {
+        const std::size_t lanes = std::min(KEPLER_LANES, end - base);
+        double rx[KEPLER_LANES]; // Position relative to the center
+        double ry[KEPLER_LANES];
+        double r0[KEPLER_LANES]; // Initial distance
+        double sigma[KEPLER_LANES]; // r . v / sqrt(mu)
+        double alpha[KEPLER_LANES]; // Inverse semi-major axis, negative if unbound
+        double time[KEPLER_LANES]; // Time to cover, bound orbits reduced to one period
+        double chi[KEPLER_LANES]; // Universal anomaly
+        double c2[KEPLER_LANES];
+        double c3[KEPLER_LANES];
+
+        for (std::size_t k = 0; k < lanes; ++k) {
+            const std::size_t i = base + k;
+            rx[k] = x[i] - centerX;
+            ry[k] = y[i] - centerY;
+            r0[k] = std::sqrt(rx[k] * rx[k] + ry[k] * ry[k]);
+            sigma[k] = (rx[k] * vx[i] + ry[k] * vy[i]) / sqrtMu;
+            alpha[k] = 2.0 / r0[k] - (vx[i] * vx[i] + vy[i] * vy[i]) / mu;
+            time[k] = dt;
+            chi[k] = sqrtMu * dt / r0[k];
+            if (alpha[k] > 0.0) {
+                const double period
+                    = 2.0 * std::numbers::pi / (sqrtMu * alpha[k] * std::sqrt(alpha[k]));
+                time[k] = std::fmod(dt, period);
+                chi[k] = sqrtMu * alpha[k] * time[k];
+            }
+        }
+
+        // Laguerre-Conway on the universal Kepler equation, all lanes together
+        for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+            double worst = 0.0;
+            for (std::size_t k = 0; k < lanes; ++k) {
+                const double z = alpha[k] * chi[k] * chi[k];
+                stumpff(z, c2[k], c3[k]);
+                const double eccentric = 1.0 - alpha[k] * r0[k];
+                const double chiSq = chi[k] * chi[k];
+                const double f = sigma[k] * chiSq * c2[k] + eccentric * chiSq * chi[k] * c3[k]
+                    + r0[k] * chi[k] - sqrtMu * time[k];
+                const double slope
+                    = sigma[k] * chi[k] * (1.0 - z * c3[k]) + eccentric * chiSq * c2[k] + r0[k];
+                const double curve
+                    = sigma[k] * (1.0 - z * c2[k]) + eccentric * chi[k] * (1.0 - z * c3[k]);
+                const double root = std::sqrt(std::abs(16.0 * slope * slope - 20.0 * f * curve));
+                const double delta = 5.0 * f / (slope + std::copysign(root, slope));
+                chi[k] -= delta;
+                worst = std::max(worst, std::abs(delta) / (std::abs(chi[k]) + r0[k] / sqrtMu));
+            }
+            if (worst <= 4.0 * std::numeric_limits<double>::epsilon())
+                break;
+        }
+
+        // The f and g functions of the converged anomaly
+        for (std::size_t k = 0; k < lanes; ++k) {
+            const std::size_t i = base + k;
+            const double z = alpha[k] * chi[k] * chi[k];
+            stumpff(z, c2[k], c3[k]);
+            const double chiSq = chi[k] * chi[k];
+            const double f = 1.0 - chiSq * c2[k] / r0[k];
+            const double g = time[k] - chiSq * chi[k] * c3[k] / sqrtMu;
+            const double nx = f * rx[k] + g * vx[i];
+            const double ny = f * ry[k] + g * vy[i];
+            const double r = std::sqrt(nx * nx + ny * ny);
+            const double fDot = sqrtMu * chi[k] * (z * c3[k] - 1.0) / (r * r0[k]);
+            const double gDot = 1.0 - chiSq * c2[k] / r;
+            const double nvx = fDot * rx[k] + gDot * vx[i];
+            const double nvy = fDot * ry[k] + gDot * vy[i];
+            x[i] = centerX + nx;
+            y[i] = centerY + ny;
+            vx[i] = nvx;
+            vy[i] = nvy;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/kepler_propagator.h"
+
+#include "body_store.h"
+#include "integrators/kepler.h"
+
+void KeplerPropagator::reset(double mu, const Vector2& center, double epoch)
+{
+    this->mu = mu;
+    centerX = center[0];
+    centerY = center[1];
+    this->epoch = epoch;
+    slots.clear();
+    epochX.clear();
+    epochY.clear();
+    epochVX.clear();
+    epochVY.clear();
+}
+
+void KeplerPropagator::add(std::size_t slot, const Vector2& pos, const Vector2& vel)
+{
+    slots.push_back(static_cast<std::uint32_t>(slot));
+    epochX.push_back(pos[0]);
+    epochY.push_back(pos[1]);
+    epochVX.push_back(vel[0]);
+    epochVY.push_back(vel[1]);
+}
+
+[[nodiscard]] std::size_t KeplerPropagator::size() const noexcept
+{
+    return slots.size();
+}
+
+[[nodiscard]] const std::vector<std::uint32_t>& KeplerPropagator::getSlots() const noexcept
+{
+    return slots;
+}
+
+[[nodiscard]] double KeplerPropagator::getEpoch() const noexcept
+{
+    return epoch;
+}
+
+void KeplerPropagator::propagate(double time, BodyStore& bodies, ThreadPool* pool)
+{
+    const std::size_t count = slots.size();
+    x = epochX;
+    y = epochY;
+    vx = epochVX;
+    vy = epochVY;
+    double* px = bodies.x();
+    double* py = bodies.y();
+    double* pvx = bodies.vx();
+    double* pvy = bodies.vy();
+    const double dt = time - epoch;
+    auto jump = [&](std::size_t begin, std::size_t end, std::size_t) {
+        keplerDrift(mu, centerX, centerY, dt, begin, end, x.data(), y.data(), vx.data(), vy.data());
+        for (std::size_t k = begin; k < end; ++k) {
+            const std::uint32_t slot = slots[k];
+            px[slot] = x[k];
+            py[slot] = y[k];
+            pvx[slot] = vx[k];
+            pvy[slot] = vy[k];
+        }
+    };
+    if (pool && pool->getWorkerCount() > 1)
+        pool->parallelFor(count, jump, KEPLER_LANES * 16);
+    else
+        jump(0, count, 0);
+}
@@ -0,0 +1,97 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/leapfrog.h"
+
+#include "body_store.h"
+
+template <uint32_t DIM>
+void BasicLeapfrogIntegrator<DIM>::step(
+    BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt)
+{
+    if (bodies.size() < 2)
+        return;
+    this->prepareCompensation(bodies);
+    for (const double weight : weights)
+        kickDriftKick(bodies, solver, weight * dt);
+    this->keepCompensation(bodies);
+}
+
+template <uint32_t DIM>
+void BasicLeapfrogIntegrator<DIM>::advance(
+    BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt, std::size_t steps)
+{
+    if (bodies.size() < 2 || steps == 0)
+        return;
+    this->updateAccelerations(bodies, solver);
+    this->prepareCompensation(bodies);
+    const std::size_t stages = weights.size();
+    double pending = 0.5 * weights[0] * dt;
+    for (std::size_t n = 0; n < steps; ++n) {
+        for (std::size_t k = 0; k < stages; ++k) {
+            kick(bodies, pending);
+            drift(bodies, weights[k] * dt);
+            this->evaluateAccelerations(bodies, solver);
+            // Closing half kick of this sub-step plus opening half kick of the next
+            pending = 0.5 * (weights[k] + weights[(k + 1) % stages]) * dt;
+        }
+    }
+    kick(bodies, 0.5 * weights[stages - 1] * dt);
+    bodies.touch();
+    this->keepAccelerations(bodies, solver);
+    this->keepCompensation(bodies);
+}
+
+template <uint32_t DIM>
+void BasicLeapfrogIntegrator<DIM>::kickDriftKick(
+    BasicBodyStore<DIM>& bodies, BasicForceSolver<DIM>& solver, double dt)
+{
+    this->updateAccelerations(bodies, solver);
+    kick(bodies, 0.5 * dt);
+    drift(bodies, dt);
+    bodies.touch();
+    this->updateAccelerations(bodies, solver);
+    kick(bodies, 0.5 * dt);
+}
+
+template <uint32_t DIM>
+void BasicLeapfrogIntegrator<DIM>::kick(BasicBodyStore<DIM>& bodies, double dt)
+{
+    const bool compensated = this->getCompensation();
+    this->forEachBody(bodies.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (uint32_t axis = 0; axis < DIM; ++axis) {
+            double* v = bodies.vel(axis);
+            const double* a = this->acc[axis].data();
+            if (compensated) {
+                double* carry = this->velCarry[axis].data();
+                for (std::size_t i = begin; i < end; ++i)
+                    this->compensatedAdd(v[i], carry[i], dt * a[i]);
+                continue;
+            }
+            for (std::size_t i = begin; i < end; ++i)
+                v[i] += dt * a[i];
+        }
+    });
+}
+
+template <uint32_t DIM>
+void BasicLeapfrogIntegrator<DIM>::drift(BasicBodyStore<DIM>& bodies, double dt)
+{
+    const bool compensated = this->getCompensation();
+    this->forEachBody(bodies.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (uint32_t axis = 0; axis < DIM; ++axis) {
+            double* x = bodies.pos(axis);
+            const double* v = bodies.vel(axis);
+            if (compensated) {
+                double* carry = this->posCarry[axis].data();
+                for (std::size_t i = begin; i < end; ++i)
+                    this->compensatedAdd(x[i], carry[i], dt * v[i]);
+                continue;
+            }
+            for (std::size_t i = begin; i < end; ++i)
+                x[i] += dt * v[i];
+        }
+    });
+}
+
+template class BasicLeapfrogIntegrator<2>;
+template class BasicLeapfrogIntegrator<3>;
@@ -0,0 +1,56 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/wisdom_holman.h"
+
+#include "body_store.h"
+#include "integrators/kepler.h"
+#include "universe.h"
+
+#include <cmath>
+
+void WisdomHolmanIntegrator::step(BodyStore& bodies, ForceSolver& solver, double dt)
+{
+    if (bodies.size() < 2)
+        return;
+    kick(bodies, solver, 0.5 * dt);
+    drift(bodies, dt);
+    kick(bodies, solver, 0.5 * dt);
+}
+
+void WisdomHolmanIntegrator::kick(BodyStore& bodies, ForceSolver& solver, double dt)
+{
+    updateAccelerations(bodies, solver);
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    double* vx = bodies.vx();
+    double* vy = bodies.vy();
+    const double sunX = x[0];
+    const double sunY = y[0];
+    const double mu = Universe::G * bodies.mass()[0];
+    forEachBody(bodies.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            // The drift already accounts for the sun
+            const double dx = sunX - x[i];
+            const double dy = sunY - y[i];
+            const double disSq = dx * dx + dy * dy;
+            const double scale = disSq == 0.0 ? 0.0 : mu / (disSq * std::sqrt(disSq));
+            vx[i] += dt * (acc[0][i] - scale * dx);
+            vy[i] += dt * (acc[1][i] - scale * dy);
+        }
+    });
+}
+
+void WisdomHolmanIntegrator::drift(BodyStore& bodies, double dt)
+{
+    double* x = bodies.x();
+    double* y = bodies.y();
+    double* vx = bodies.vx();
+    double* vy = bodies.vy();
+    const double sunX = x[0];
+    const double sunY = y[0];
+    const double mu = Universe::G * bodies.mass()[0];
+    forEachBody(bodies.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+        keplerDrift(mu, sunX, sunY, dt, begin, end, x, y, vx, vy);
+    });
+    bodies.touch();
+}
@@ -0,0 +1,35 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "integrators/yoshida.h"
+
+#include <cmath>
+#include <stdexcept>
+
+template <uint32_t DIM>
+BasicYoshidaIntegrator<DIM>::BasicYoshidaIntegrator(std::uint32_t order)
+    : order(order)
+{
+    if (order == 4) {
+        const double cbrt2 = std::cbrt(2.0);
+        const double outer = 1.0 / (2.0 - cbrt2);
+        this->weights = { outer, -cbrt2 * outer, outer };
+    } else if (order == 6) {
+        // Solution A of Yoshida's table 1
+        const double w1 = -1.17767998417887;
+        const double w2 = 0.235573213359357;
+        const double w3 = 0.784513610477560;
+        const double w0 = 1.0 - 2.0 * (w1 + w2 + w3);
+        this->weights = { w3, w2, w1, w0, w1, w2, w3 };
+    } else {
+        throw std::logic_error("Yoshida composition order must be 4 or 6");
+    }
+}
+
+template <uint32_t DIM>
+[[nodiscard]] std::uint32_t BasicYoshidaIntegrator<DIM>::getOrder() const noexcept
+{
+    return order;
+}
+
+template class BasicYoshidaIntegrator<2>;
+template class BasicYoshidaIntegrator<3>;
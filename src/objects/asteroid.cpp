@@ -13,7 +13,9 @@ void Asteroid::accept(Visitor& visitor)
 
 [[nodiscard]] Asteroid* Asteroid::clone() const
 {
-    Asteroid* temp = new Asteroid(name, mass, position, velocity);
+    Asteroid* temp = new Asteroid(name, getMass(), getPosition(), getVelocity());
+    temp->setTestParticle(isTestParticle());
+    temp->setRadius(getRadius());
     return temp;
 }
 
@@ -10,7 +10,9 @@ void Comet::accept(Visitor& visitor)
 
 [[nodiscard]] Comet* Comet::clone() const
 {
-    Comet* temp = new Comet(name, mass, position, velocity, composition);
+    Comet* temp = new Comet(name, getMass(), getPosition(), getVelocity(), composition);
+    temp->setTestParticle(isTestParticle());
+    temp->setRadius(getRadius());
     return temp;
 }
 
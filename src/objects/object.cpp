@@ -2,13 +2,14 @@
 // pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
 #include "objects/object.h"
 
+#include "body_store.h"
 #include "universe.h"
 #include "vector.h"
 #include <string>
 
 [[nodiscard]] double Object::getMass() const noexcept
 {
-    return mass;
+    return store ? store->getMass(slot) : mass;
 }
 
 [[nodiscard]] std::string Object::getName() const noexcept
@@ -18,40 +19,74 @@
 
 [[nodiscard]] Vector2 Object::getPosition() const noexcept
 {
-    return position;
+    return store ? store->getPosition(slot) : position;
 }
 
 [[nodiscard]] Vector2 Object::getVelocity() const noexcept
 {
-    return velocity;
+    return store ? store->getVelocity(slot) : velocity;
 }
 
 [[nodiscard]] Vector2 Object::getForce(const Object& rhs) const noexcept
 {
-    if (rhs.getPosition() == position) {
+    const Vector2 pos = getPosition();
+    const Vector2 rhsPos = rhs.getPosition();
+    if (rhsPos == pos) {
         return Vector2();
     }
-    Vector2 distanceVec = rhs.position - position;
+    Vector2 distanceVec = rhsPos - pos;
     double disSq = distanceVec.normSq();
-    auto force = Universe::G * mass * rhs.mass / disSq;
+    auto force = Universe::G * getMass() * rhs.getMass() / disSq;
     auto direct = distanceVec.normalize();
     return force * direct;
 }
 
 void Object::setPosition(const Vector2& pos)
 {
-    position = pos;
+    if (store)
+        store->setPosition(slot, pos);
+    else
+        position = pos;
 }
 
 void Object::setVelocity(const Vector2& vel)
 {
-    velocity = vel;
+    if (store)
+        store->setVelocity(slot, vel);
+    else
+        velocity = vel;
+}
+
+[[nodiscard]] bool Object::isTestParticle() const noexcept
+{
+    return store ? store->isParticle(slot) : testParticle;
+}
+
+void Object::setTestParticle(bool particle)
+{
+    if (store)
+        store->setParticle(slot, particle);
+    else
+        testParticle = particle;
+}
+
+[[nodiscard]] double Object::getRadius() const noexcept
+{
+    return store ? store->getRadius(slot) : radius;
+}
+
+void Object::setRadius(double radius)
+{
+    if (store)
+        store->setRadius(slot, radius);
+    else
+        this->radius = radius;
 }
 
 bool Object::operator==(const Object& rhs) const
 {
-    if (name == rhs.name && mass == rhs.mass && position == rhs.position
-        && velocity == rhs.velocity)
+    if (name == rhs.name && getMass() == rhs.getMass() && getPosition() == rhs.getPosition()
+        && getVelocity() == rhs.getVelocity())
         return true;
     return false;
 }
@@ -68,3 +103,22 @@ Object::Object(const std::string& name, double mass, const Vector2& pos, const V
     , velocity(vel)
 {
 }
+
+void Object::bind(BodyStore* store, std::size_t slot) noexcept
+{
+    this->store = store;
+    this->slot = slot;
+}
+
+void Object::unbind() noexcept
+{
+    if (!store)
+        return;
+    mass = store->getMass(slot);
+    position = store->getPosition(slot);
+    velocity = store->getVelocity(slot);
+    testParticle = store->isParticle(slot);
+    radius = store->getRadius(slot);
+    store = nullptr;
+    slot = 0;
+}
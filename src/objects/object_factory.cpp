@@ -17,25 +17,36 @@ class Star;
 
 Planet* ObjectFactory::makePlanet(
     const std::string& name, double mass, const Vector2& pos, const Vector2& vel)
+{
+    return makePlanet(*Universe::instance(), name, mass, pos, vel);
+}
+
+Planet* ObjectFactory::makePlanet(Universe& universe, const std::string& name, double mass,
+    const Vector2& pos, const Vector2& vel)
 {
     checkMass(mass, 1e21);
 
     Planet* raw = new Planet(name, mass, pos, vel);
     std::unique_ptr<Planet> guard(raw);
 
-    Universe::inst->addObject(raw);
+    universe.addObject(raw);
 
     guard.release();
     return raw;
 }
 
 Star* ObjectFactory::makeStar(const std::string& name, double mass)
+{
+    return makeStar(*Universe::instance(), name, mass);
+}
+
+Star* ObjectFactory::makeStar(Universe& universe, const std::string& name, double mass)
 {
     checkMass(mass, 1e30);
     Star* raw = new Star(name, mass);
     std::unique_ptr<Star> guard(raw);
 
-    Universe::inst->addObject(raw);
+    universe.addObject(raw);
 
     guard.release();
     return raw;
@@ -43,12 +54,18 @@ Star* ObjectFactory::makeStar(const std::string& name, double mass)
 
 Asteroid* ObjectFactory::makeAsteroid(
     const std::string& name, double mass, const Vector2& pos, const Vector2& vel)
+{
+    return makeAsteroid(*Universe::instance(), name, mass, pos, vel);
+}
+
+Asteroid* ObjectFactory::makeAsteroid(Universe& universe, const std::string& name, double mass,
+    const Vector2& pos, const Vector2& vel)
 {
     checkMassUpper(mass, 1e21);
     Asteroid* raw = new Asteroid(name, mass, pos, vel);
     std::unique_ptr<Asteroid> guard(raw);
 
-    Universe::inst->addObject(raw);
+    universe.addObject(raw);
 
     guard.release();
     return raw;
@@ -56,12 +73,18 @@ Asteroid* ObjectFactory::makeAsteroid(
 
 Comet* ObjectFactory::makeComet(const std::string& name, double mass, const Vector2& pos,
     const Vector2& vel, const std::string& comp)
+{
+    return makeComet(*Universe::instance(), name, mass, pos, vel, comp);
+}
+
+Comet* ObjectFactory::makeComet(Universe& universe, const std::string& name, double mass,
+    const Vector2& pos, const Vector2& vel, const std::string& comp)
 {
     checkMass(mass);
     Comet* raw = new Comet(name, mass, pos, vel, comp);
     std::unique_ptr<Comet> guard(raw);
 
-    Universe::inst->addObject(raw);
+    universe.addObject(raw);
 
     guard.release();
     return raw;
@@ -70,100 +93,164 @@ Comet* ObjectFactory::makeComet(const std::string& name, double mass, const Vect
 // Quick helpers for our solar system
 Star* ObjectFactory::makeSun()
 {
-    return makeStar("sun", 1.98892e30);
+    return makeSun(*Universe::instance());
+}
+Star* ObjectFactory::makeSun(Universe& universe)
+{
+    return makeStar(universe, "sun", 1.98892e30);
 }
 Planet* ObjectFactory::makeMercury()
+{
+    return makeMercury(*Universe::instance());
+}
+Planet* ObjectFactory::makeMercury(Universe& universe)
 {
     double pos[] = { 60000000000, 0 };
     double vel[] = { 0, 47360.00 };
-    return makePlanet("mercury", 3.3011e23, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "mercury", 3.3011e23, Vector2(pos), Vector2(vel));
 }
 Planet* ObjectFactory::makeVenus()
+{
+    return makeVenus(*Universe::instance());
+}
+Planet* ObjectFactory::makeVenus(Universe& universe)
 {
     double pos[] = { 108000000000, 0 };
     double vel[] = { 0, 35020.00 };
-    return makePlanet("venus", 4.8675e24, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "venus", 4.8675e24, Vector2(pos), Vector2(vel));
 }
 Planet* ObjectFactory::makeEarth()
+{
+    return makeEarth(*Universe::instance());
+}
+Planet* ObjectFactory::makeEarth(Universe& universe)
 {
     double pos[] = { 149597870700, 0 };
     double vel[] = { 0, 29788.4676 };
-    return makePlanet("earth", 5.9742e24, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "earth", 5.9742e24, Vector2(pos), Vector2(vel));
 }
 Planet* ObjectFactory::makeMars()
+{
+    return makeMars(*Universe::instance());
+}
+Planet* ObjectFactory::makeMars(Universe& universe)
 {
     double pos[] = { 228000000000, 0 };
     double vel[] = { 0, 24070.00 };
-    return makePlanet("mars", 6.417e23, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "mars", 6.417e23, Vector2(pos), Vector2(vel));
 }
 Planet* ObjectFactory::makeJupiter()
+{
+    return makeJupiter(*Universe::instance());
+}
+Planet* ObjectFactory::makeJupiter(Universe& universe)
 {
     double pos[] = { 780000000000, 0 };
     double vel[] = { 0, 13070.00 };
-    return makePlanet("jupiter", 1.8982e27, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "jupiter", 1.8982e27, Vector2(pos), Vector2(vel));
 }
 Planet* ObjectFactory::makeSaturn()
+{
+    return makeSaturn(*Universe::instance());
+}
+Planet* ObjectFactory::makeSaturn(Universe& universe)
 {
     double pos[] = { 1450000000000, 0 };
     double vel[] = { 0, 9680.00 };
-    return makePlanet("saturn", 5.6834e26, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "saturn", 5.6834e26, Vector2(pos), Vector2(vel));
 }
 Planet* ObjectFactory::makeUranus()
+{
+    return makeUranus(*Universe::instance());
+}
+Planet* ObjectFactory::makeUranus(Universe& universe)
 {
     double pos[] = { 2850000000000, 0 };
     double vel[] = { 0, 6800.00 };
-    return makePlanet("uranus", 8.6810e25, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "uranus", 8.6810e25, Vector2(pos), Vector2(vel));
 }
 Planet* ObjectFactory::makeNeptune()
+{
+    return makeNeptune(*Universe::instance());
+}
+Planet* ObjectFactory::makeNeptune(Universe& universe)
 {
     double pos[] = { 4500000000000, 0 };
     double vel[] = { 0, 5430.00 };
-    return makePlanet("neptune", 1.02409e26, Vector2(pos), Vector2(vel));
+    return makePlanet(universe, "neptune", 1.02409e26, Vector2(pos), Vector2(vel));
 }
 
 Asteroid* ObjectFactory::make1Ceres()
+{
+    return make1Ceres(*Universe::instance());
+}
+Asteroid* ObjectFactory::make1Ceres(Universe& universe)
 {
     double pos[] = { 4.14e11, 0 };
     double vel[] = { 0, 17900 };
-    return makeAsteroid("1 ceres", 9.3839e20, Vector2(pos), Vector2(vel));
+    return makeAsteroid(universe, "1 ceres", 9.3839e20, Vector2(pos), Vector2(vel));
 }
 Asteroid* ObjectFactory::make4Vesta()
+{
+    return make4Vesta(*Universe::instance());
+}
+Asteroid* ObjectFactory::make4Vesta(Universe& universe)
 {
     double pos[] = { 3.53e11, 0 };
     double vel[] = { 0, 19340 };
-    return makeAsteroid("4 vesta", 2.590271e20, Vector2(pos), Vector2(vel));
+    return makeAsteroid(universe, "4 vesta", 2.590271e20, Vector2(pos), Vector2(vel));
 }
 Asteroid* ObjectFactory::make2Pallas()
+{
+    return make2Pallas(*Universe::instance());
+}
+Asteroid* ObjectFactory::make2Pallas(Universe& universe)
 {
     double pos[] = { 4.14e11, 0 };
     double vel[] = { 0, 17900 };
-    return makeAsteroid("2 pallas", 2.04e20, Vector2(pos), Vector2(vel));
+    return makeAsteroid(universe, "2 pallas", 2.04e20, Vector2(pos), Vector2(vel));
 }
 Asteroid* ObjectFactory::make10Hygiea()
+{
+    return make10Hygiea(*Universe::instance());
+}
+Asteroid* ObjectFactory::make10Hygiea(Universe& universe)
 {
     double pos[] = { 4.7e11, 0 };
     double vel[] = { 0, 16800 };
-    return makeAsteroid("10 hygiea", 8.74e19, Vector2(pos), Vector2(vel));
+    return makeAsteroid(universe, "10 hygiea", 8.74e19, Vector2(pos), Vector2(vel));
 }
 Asteroid* ObjectFactory::make704Interamnia()
+{
+    return make704Interamnia(*Universe::instance());
+}
+Asteroid* ObjectFactory::make704Interamnia(Universe& universe)
 {
     double pos[] = { 4.57e11, 0 };
     double vel[] = { 0, 16920 };
-    return makeAsteroid("704 interamnia", 3.5e19, Vector2(pos), Vector2(vel));
+    return makeAsteroid(universe, "704 interamnia", 3.5e19, Vector2(pos), Vector2(vel));
 }
 
 Comet* ObjectFactory::makeHalley()
+{
+    return makeHalley(*Universe::instance());
+}
+Comet* ObjectFactory::makeHalley(Universe& universe)
 {
     double pos[] = { 2.6534e12, 0 };
     double vel[] = { 0, 7040 };
-    return makeComet("halley's", 2.2e14, Vector2(pos), Vector2(vel), "ice");
+    return makeComet(universe, "halley's", 2.2e14, Vector2(pos), Vector2(vel), "ice");
 }
 
 Comet* ObjectFactory::makeHaleBopp()
+{
+    return makeHaleBopp(*Universe::instance());
+}
+Comet* ObjectFactory::makeHaleBopp(Universe& universe)
 {
     double pos[] = { 2.65e13, 0 };
     double vel[] = { 0, 2240 };
-    return makeComet("hale–bopp", 1.9e14, Vector2(pos), Vector2(vel), "ice");
+    return makeComet(universe, "hale–bopp", 1.9e14, Vector2(pos), Vector2(vel), "ice");
 }
 
 void ObjectFactory::checkMass(const double& mass, double limit)
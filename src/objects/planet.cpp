@@ -10,7 +10,9 @@ void Planet::accept(Visitor& visitor)
 
 [[nodiscard]] Planet* Planet::clone() const
 {
-    Planet* temp = new Planet(name, mass, position, velocity);
+    Planet* temp = new Planet(name, getMass(), getPosition(), getVelocity());
+    temp->setTestParticle(isTestParticle());
+    temp->setRadius(getRadius());
     return temp;
 }
 
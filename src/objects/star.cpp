@@ -14,7 +14,9 @@ void Star::accept(Visitor& visitor)
 
 [[nodiscard]] Star* Star::clone() const
 {
-    Star* temp = new Star(name, mass);
+    Star* temp = new Star(name, getMass());
+    temp->setTestParticle(isTestParticle());
+    temp->setRadius(getRadius());
     return temp;
 }
 
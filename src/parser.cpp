@@ -2,13 +2,42 @@
 // Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
 // pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
 #include "parser.h"
+#include "objects/asteroid.h"
+#include "objects/comet.h"
 #include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "universe.h"
 #include <fstream>
 #include <iostream>
 #include <nlohmann/json.hpp>
+#include <stdexcept>
 #include <string>
 
+namespace {
+
+/**
+ * Reads a vector of up to DIM components, the missing ones are zero
+ * @param el - JSON array of numbers
+ */
+template <uint32_t DIM> Vector<DIM> readVector(const nlohmann::json& el)
+{
+    if (el.size() > DIM)
+        throw std::logic_error("Vector has more components than the simulation has axes");
+    Vector<DIM> vec;
+    for (uint32_t axis = 0; axis < el.size(); ++axis)
+        vec[axis] = el[axis];
+    return vec;
+}
+
+} // anonymous namespace
+
 void Parser::loadFile(const std::string& filename)
+{
+    loadFile(*Universe::instance(), filename);
+}
+
+void Parser::loadFile(Universe& universe, const std::string& filename)
 {
     std::ifstream config(filename);
     if (config.fail()) {
@@ -36,23 +65,52 @@ void Parser::loadFile(const std::string& filename)
             Vector2 velVec;
             velVec[0] = vel[0];
             velVec[1] = vel[1];
+            Object* created = nullptr;
             if (el.contains("comp")) {
                 const std::string composi = el["comp"];
-                ObjectFactory::makeComet(name, mass, posVec, velVec, composi);
+                created = ObjectFactory::makeComet(universe, name, mass, posVec, velVec, composi);
             } else {
                 if (mass >= 1e21)
-                    ObjectFactory::makePlanet(name, mass, posVec, velVec);
+                    created = ObjectFactory::makePlanet(universe, name, mass, posVec, velVec);
                 else
-                    ObjectFactory::makeAsteroid(name, mass, posVec, velVec);
+                    created = ObjectFactory::makeAsteroid(universe, name, mass, posVec, velVec);
             }
+            // Test particle: feels the others but pulls on nobody
+            if (el.value("particle", false))
+                created->setTestParticle(true);
+            created->setRadius(el.value("radius", 0.0));
 
         }
 
         else {
             // Create the star object - rooted at zero, zero with no velocity
-            ObjectFactory::makeStar(name, mass);
+            ObjectFactory::makeStar(universe, name, mass)->setRadius(el.value("radius", 0.0));
         }
         // Close the input file
         config.close();
     }
 }
+
+template <uint32_t DIM>
+void Parser::loadBodies(const std::string& filename, BasicBodyStore<DIM>& bodies)
+{
+    std::ifstream config(filename);
+    if (config.fail())
+        throw std::logic_error("Parser not able to open file: " + filename);
+
+    const auto json = nlohmann::json::parse(config);
+    for (const auto& el : json) {
+        const double mass = el["mass"];
+        std::size_t slot = 0;
+        if (el.contains("pos")) {
+            slot = bodies.add(mass, readVector<DIM>(el["pos"]), readVector<DIM>(el["vel"]),
+                el.value("particle", false));
+        } else {
+            slot = bodies.add(mass, Vector<DIM>(), Vector<DIM>());
+        }
+        bodies.setRadius(slot, el.value("radius", 0.0));
+    }
+}
+
+template void Parser::loadBodies<2>(const std::string&, BodyStore&);
+template void Parser::loadBodies<3>(const std::string&, BodyStore3&);
@@ -0,0 +1,245 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/barnes_hut.h"
+
+#include "body_store.h"
+#include "solvers/morton.h"
+#include "thread_pool.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::uint32_t MAX_LEVEL = morton::BITS - 1; // Deepest level that still has a quadrant
+constexpr std::uint32_t LEAF_CAPACITY = 8; // Cells with this few bodies are not split
+constexpr std::uint32_t TASK_BODIES = 256; // Subtrees with this few bodies are one task
+
+} // anonymous namespace
+
+BarnesHutSolver::BarnesHutSolver(double theta)
+    : theta(0.0)
+{
+    setTheta(theta);
+}
+
+void BarnesHutSolver::setTheta(double theta)
+{
+    if (!(theta >= 0.0))
+        throw std::logic_error("Opening angle must not be negative");
+    this->theta = theta;
+    touch();
+}
+
+[[nodiscard]] double BarnesHutSolver::getTheta() const noexcept
+{
+    return theta;
+}
+
+[[nodiscard]] std::size_t BarnesHutSolver::getNodeCount() const noexcept
+{
+    return nodes.size();
+}
+
+void BarnesHutSolver::accumulate(const BodyStore& bodies, const Axes& acc)
+{
+    double* ax = acc[0];
+    double* ay = acc[1];
+    const std::size_t count = bodies.size();
+    if (count == 0)
+        return;
+
+    const double rootSize = sortBodies(bodies);
+    nodes.clear();
+    nodes.push_back(Node { rootSize, 0.0, 0.0, 0.0, 0, static_cast<std::uint32_t>(count), 0, 0 });
+    build(0, 0);
+
+    // The tree is read only from here on. Targets are walked in Morton order,
+    // so consecutive walks open mostly the same cells
+    sortedAx.resize(count);
+    sortedAy.resize(count);
+    if (isParallel()) {
+        // One task per subtree, split until the subtrees are small enough
+        ThreadPool& pool = *getThreadPool();
+        stacks.resize(pool.getWorkerCount());
+        ThreadPool::TaskGroup group(pool);
+        std::function<void(std::uint32_t)> traverse = [&](std::uint32_t index) {
+            const Node& node = nodes[index];
+            if (node.end - node.begin <= TASK_BODIES || node.childCount == 0) {
+                walkRange(node.begin, node.end, stacks[pool.currentWorker()]);
+                return;
+            }
+            for (std::uint32_t child = 0; child < node.childCount; ++child)
+                group.run([&traverse, index = node.firstChild + child] { traverse(index); });
+        };
+        traverse(0);
+        group.wait();
+    } else {
+        stacks.resize(1);
+        walkRange(0, static_cast<std::uint32_t>(count), stacks[0]);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t slot = keys[i].second;
+        ax[slot] = sortedAx[i];
+        ay[slot] = sortedAy[i];
+    }
+    ax[0] = 0.0;
+    ay[0] = 0.0;
+}
+
+double BarnesHutSolver::sortBodies(const BodyStore& bodies)
+{
+    const std::size_t count = bodies.size();
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* mass = bodies.activeMass();
+
+    const auto [minX, maxX] = std::minmax_element(x, x + count);
+    const auto [minY, maxY] = std::minmax_element(y, y + count);
+    double size = std::max(*maxX - *minX, *maxY - *minY);
+    if (size == 0.0)
+        size = 1.0;
+    // Scale so that the far edge maps just inside the 31 bit grid
+    const double scale = morton::GRID / size;
+
+    keys.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto qx = static_cast<std::uint64_t>((x[i] - *minX) * scale);
+        const auto qy = static_cast<std::uint64_t>((y[i] - *minY) * scale);
+        keys[i] = { morton::encode(qx, qy), static_cast<std::uint32_t>(i) };
+    }
+    std::sort(keys.begin(), keys.end());
+
+    sortedX.resize(count);
+    sortedY.resize(count);
+    sortedMass.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t slot = keys[i].second;
+        sortedX[i] = x[slot];
+        sortedY[i] = y[slot];
+        sortedMass[i] = mass[slot];
+    }
+    return size;
+}
+
+void BarnesHutSolver::build(std::uint32_t index, std::uint32_t level)
+{
+    const std::uint32_t begin = nodes[index].begin;
+    const std::uint32_t end = nodes[index].end;
+
+    if (end - begin > LEAF_CAPACITY && level <= MAX_LEVEL) {
+        // Keys are sorted, so each quadrant is a contiguous sub-range
+        const std::uint32_t shift = 2 * (MAX_LEVEL - level);
+        std::uint32_t bounds[5];
+        bounds[0] = begin;
+        for (std::uint64_t quadrant = 1; quadrant < 4; ++quadrant) {
+            auto below = [shift, quadrant](const auto& key) {
+                return ((key.first >> shift) & 3) < quadrant;
+            };
+            auto it = std::partition_point(
+                keys.begin() + bounds[quadrant - 1], keys.begin() + end, below);
+            bounds[quadrant] = static_cast<std::uint32_t>(it - keys.begin());
+        }
+        bounds[4] = end;
+
+        const auto firstChild = static_cast<std::uint32_t>(nodes.size());
+        const double childSize = nodes[index].size * 0.5;
+        for (std::uint32_t quadrant = 0; quadrant < 4; ++quadrant) {
+            const std::uint32_t first = bounds[quadrant];
+            const std::uint32_t last = bounds[quadrant + 1];
+            if (first != last)
+                nodes.push_back(Node { childSize, 0.0, 0.0, 0.0, first, last, 0, 0 });
+        }
+        const auto childCount = static_cast<std::uint32_t>(nodes.size()) - firstChild;
+        nodes[index].firstChild = firstChild;
+        nodes[index].childCount = childCount;
+
+        double mass = 0.0;
+        double momentX = 0.0;
+        double momentY = 0.0;
+        for (std::uint32_t child = firstChild; child < firstChild + childCount; ++child) {
+            build(child, level + 1);
+            mass += nodes[child].mass;
+            momentX += nodes[child].mass * nodes[child].comX;
+            momentY += nodes[child].mass * nodes[child].comY;
+        }
+        nodes[index].mass = mass;
+        nodes[index].comX = mass > 0.0 ? momentX / mass : 0.0;
+        nodes[index].comY = mass > 0.0 ? momentY / mass : 0.0;
+        return;
+    }
+
+    // Leaf: moments straight from the bodies
+    double mass = 0.0;
+    double momentX = 0.0;
+    double momentY = 0.0;
+    for (std::uint32_t i = begin; i < end; ++i) {
+        mass += sortedMass[i];
+        momentX += sortedMass[i] * sortedX[i];
+        momentY += sortedMass[i] * sortedY[i];
+    }
+    nodes[index].mass = mass;
+    nodes[index].comX = mass > 0.0 ? momentX / mass : 0.0;
+    nodes[index].comY = mass > 0.0 ? momentY / mass : 0.0;
+}
+
+void BarnesHutSolver::walkRange(
+    std::uint32_t begin, std::uint32_t end, std::vector<std::uint32_t>& stack)
+{
+    for (std::uint32_t i = begin; i < end; ++i) {
+        double sumX = 0.0;
+        double sumY = 0.0;
+        walk(i, stack, sumX, sumY);
+        sortedAx[i] = sumX;
+        sortedAy[i] = sumY;
+    }
+}
+
+void BarnesHutSolver::walk(
+    std::uint32_t target, std::vector<std::uint32_t>& stack, double& ax, double& ay) const
+{
+    const double px = sortedX[target];
+    const double py = sortedY[target];
+    const double thetaSq = theta * theta;
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.mass == 0.0)
+            continue;
+
+        const double dx = node.comX - px;
+        const double dy = node.comY - py;
+        const double disSq = dx * dx + dy * dy;
+        // A cell holding the target is always opened, or with theta >= 1 the
+        // target could pull on itself through the center of mass
+        const bool holdsTarget = node.begin <= target && target < node.end;
+        if (!holdsTarget && node.size * node.size < thetaSq * disSq) {
+            // Far enough away to act as a single point mass
+            const double scale = Universe::G * node.mass / (disSq * std::sqrt(disSq));
+            ax += scale * dx;
+            ay += scale * dy;
+        } else if (node.childCount == 0) {
+            for (std::uint32_t i = node.begin; i < node.end; ++i) {
+                const double bx = sortedX[i] - px;
+                const double by = sortedY[i] - py;
+                const double bodyDisSq = bx * bx + by * by;
+                // Coincident bodies (including the target itself) exert no force
+                if (bodyDisSq == 0.0)
+                    continue;
+                const double scale
+                    = Universe::G * sortedMass[i] / (bodyDisSq * std::sqrt(bodyDisSq));
+                ax += scale * bx;
+                ay += scale * by;
+            }
+        } else {
+            for (std::uint32_t child = 0; child < node.childCount; ++child)
+                stack.push_back(node.firstChild + child);
+        }
+    }
+}
@@ -0,0 +1,135 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/cached_row_solver.h"
+
+#include "body_store.h"
+#include "solvers/multi_rate.h"
+#include "solvers/pruned_solver.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+template <typename Stats>
+CachedRowSolver<Stats>::CachedRowSolver(std::size_t interval)
+    : interval(1)
+{
+    setInterval(interval);
+}
+
+template <typename Stats> void CachedRowSolver<Stats>::setInterval(std::size_t interval)
+{
+    if (interval == 0)
+        throw std::logic_error("Refresh interval must be positive");
+    this->interval = interval;
+    this->touch();
+}
+
+template <typename Stats>
+[[nodiscard]] std::size_t CachedRowSolver<Stats>::getInterval() const noexcept
+{
+    return interval;
+}
+
+template <typename Stats>
+[[nodiscard]] const Stats& CachedRowSolver<Stats>::getStats() const noexcept
+{
+    return stats;
+}
+
+template <typename Stats> [[nodiscard]] double CachedRowSolver<Stats>::getReduction() const noexcept
+{
+    if (stats.directPairs == 0)
+        return 0.0;
+    return 1.0 - static_cast<double>(stats.pairs) / static_cast<double>(stats.directPairs);
+}
+
+template <typename Stats> void CachedRowSolver<Stats>::resetStats() noexcept
+{
+    stats = Stats();
+}
+
+template <typename Stats>
+void CachedRowSolver<Stats>::accumulate(const BodyStore& bodies, const Axes& acc)
+{
+    double* ax = acc[0];
+    double* ay = acc[1];
+    const std::size_t count = bodies.size();
+    if (count == 0)
+        return;
+
+    // validate() uses the kept work but leaves it and the statistics alone
+    const bool keep = !isProbing();
+    const bool refresh = isStale(bodies);
+    if (refresh && keep) {
+        lists.resize(count);
+        resize(count);
+    }
+    // Every worker owns the rows of its own targets
+    auto rows = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; ++i) {
+            if (refresh)
+                refreshRow(bodies, i, keep, ax, ay);
+            else
+                reuseRow(bodies, i, ax, ay);
+        }
+    };
+    if (isParallel())
+        getThreadPool()->parallelFor(count, rows);
+    else
+        rows(0, count, 0);
+    // The sun in slot 0 pulls on everyone but is not a target
+    ax[0] = 0.0;
+    ay[0] = 0.0;
+    if (!keep)
+        return;
+
+    // Every slot past the sun is a target, and no source pulls on itself
+    const std::vector<std::uint32_t>& current = bodies.getSources();
+    const std::size_t selfPairs
+        = std::count_if(current.begin(), current.end(), [](std::uint32_t j) { return j != 0; });
+    const std::size_t rowPairs = (count - 1) * current.size() - selfPairs;
+    ++stats.evaluations;
+    stats.directPairs += rowPairs;
+    if (refresh) {
+        ++stats.refreshes;
+        stats.pairs += rowPairs;
+        sinceRefresh = 1;
+        cached = true;
+        masses.assign(bodies.activeMass(), bodies.activeMass() + count);
+        sources = current;
+    } else {
+        ++sinceRefresh;
+        for (std::size_t i = 1; i < count; ++i)
+            stats.pairs += lists[i].size();
+    }
+    finish(bodies, refresh);
+}
+
+template <typename Stats> void CachedRowSolver<Stats>::invalidate() noexcept
+{
+    cached = false;
+}
+
+template <typename Stats>
+[[nodiscard]] bool CachedRowSolver<Stats>::hasDrifted(const BodyStore&) const
+{
+    return false;
+}
+
+template <typename Stats>
+[[nodiscard]] bool CachedRowSolver<Stats>::isStale(const BodyStore& bodies) const
+{
+    if (!cached || sinceRefresh >= interval || masses.size() != bodies.size()
+        || sources != bodies.getSources())
+        return true;
+    const double* mass = bodies.activeMass();
+    for (const std::uint32_t j : sources) {
+        if (mass[j] != masses[j])
+            return true;
+    }
+    return hasDrifted(bodies);
+}
+
+template class CachedRowSolver<MultiRateStats>;
+template class CachedRowSolver<PrunedStats>;
@@ -0,0 +1,124 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/direct_solver.h"
+
+#include "body_store.h"
+#include "thread_pool.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/**
+ * Adds the pull of the source at pos onto the target at target to sum
+ * @param target - position components of the target
+ * @param pos - position arrays of the bodies
+ * @param j - slot of the source
+ * @param mass - mass the source pulls with
+ * @param sum - acceleration of the target so far
+ * @param d - receives the separation, for the caller to reuse
+ * @return G / r^3, or 0 for coincident bodies (including the target itself)
+ */
+template <uint32_t DIM>
+inline double pull(const double (&target)[DIM], const std::array<const double*, DIM>& pos,
+    std::uint32_t j, double mass, double (&sum)[DIM], double (&d)[DIM])
+{
+    double disSq = 0.0;
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        d[axis] = pos[axis][j] - target[axis];
+        disSq += d[axis] * d[axis];
+    }
+    if (disSq == 0.0)
+        return 0.0;
+    const double scale = Universe::G / (disSq * std::sqrt(disSq));
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        sum[axis] += mass * scale * d[axis];
+    return scale;
+}
+
+} // anonymous namespace
+
+template <uint32_t DIM>
+void BasicDirectSolver<DIM>::accumulate(const BasicBodyStore<DIM>& bodies, const Axes& acc)
+{
+    const std::size_t count = bodies.size();
+    std::array<const double*, DIM> pos;
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        pos[axis] = bodies.pos(axis);
+    const double* mass = bodies.activeMass();
+    // Test particles pull on nobody, so only the sources are summed over
+    const std::vector<std::uint32_t>& sources = bodies.getSources();
+
+    // Sums the full row of sources for every target in [begin, end)
+    auto rows = [&](std::size_t begin, std::size_t end, bool particlesOnly) {
+        for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; ++i) {
+            if (particlesOnly && !bodies.isParticle(i))
+                continue;
+            double target[DIM];
+            double sum[DIM] = {};
+            double d[DIM];
+            for (uint32_t axis = 0; axis < DIM; ++axis)
+                target[axis] = pos[axis][i];
+            for (const std::uint32_t j : sources)
+                pull<DIM>(target, pos, j, mass[j], sum, d);
+            for (uint32_t axis = 0; axis < DIM; ++axis)
+                acc[axis][i] = sum[axis];
+        }
+    };
+
+    if (this->isParallel() || this->getDeterministic()) {
+        // Pair symmetry would have workers writing each other's targets, so
+        // every worker sums the full row of its own targets instead. A row is
+        // summed in source order whoever runs it, so serial runs in the
+        // deterministic mode take the same path.
+        if (this->isParallel()) {
+            this->getThreadPool()->parallelFor(count,
+                [&](std::size_t begin, std::size_t end, std::size_t) { rows(begin, end, false); });
+        } else {
+            rows(0, count, false);
+        }
+        if (count > 0) {
+            for (uint32_t axis = 0; axis < DIM; ++axis)
+                acc[axis][0] = 0.0;
+        }
+        return;
+    }
+
+    for (uint32_t axis = 0; axis < DIM; ++axis)
+        std::fill_n(acc[axis], count, 0.0);
+
+    // Visit every unordered pair of sources once and apply the pull to both ends
+    const std::size_t sourceCount = sources.size();
+    for (std::size_t a = 0; a < sourceCount; ++a) {
+        const std::uint32_t i = sources[a];
+        double target[DIM];
+        double sum[DIM] = {};
+        double d[DIM];
+        for (uint32_t axis = 0; axis < DIM; ++axis)
+            target[axis] = pos[axis][i];
+        for (std::size_t b = a + 1; b < sourceCount; ++b) {
+            const std::uint32_t j = sources[b];
+            const double scale = pull<DIM>(target, pos, j, mass[j], sum, d);
+            for (uint32_t axis = 0; axis < DIM; ++axis)
+                acc[axis][j] -= mass[i] * scale * d[axis];
+        }
+        for (uint32_t axis = 0; axis < DIM; ++axis)
+            acc[axis][i] += sum[axis];
+    }
+
+    // Test particles only feel the sources
+    if (sourceCount < count)
+        rows(1, count, true);
+
+    // The sun in slot 0 pulls on everyone but is not a target
+    if (count > 0) {
+        for (uint32_t axis = 0; axis < DIM; ++axis)
+            acc[axis][0] = 0.0;
+    }
+}
+
+template class BasicDirectSolver<2>;
+template class BasicDirectSolver<3>;
@@ -0,0 +1,460 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/fmm.h"
+
+#include "body_store.h"
+#include "solvers/morton.h"
+#include "thread_pool.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr std::uint32_t MIN_DEPTH = 2; // Shallowest level with well separated cells
+constexpr std::uint32_t MAX_DEPTH = 20; // Deepest level the tree is allowed to reach
+constexpr double CONVERGENCE = 0.5; // Conservative error reduction per expansion order
+
+/**
+ * Fills powers[0..count) with 1, z, z^2, ...
+ */
+void powers(std::complex<double> z, std::uint32_t count, std::complex<double>* powers)
+{
+    powers[0] = 1.0;
+    for (std::uint32_t i = 1; i < count; ++i)
+        powers[i] = powers[i - 1] * z;
+}
+
+} // anonymous namespace
+
+FmmSolver::FmmSolver(std::uint32_t order)
+    : order(0)
+{
+    setOrder(order);
+}
+
+void FmmSolver::setOrder(std::uint32_t order)
+{
+    if (order < 1 || order > MAX_ORDER)
+        throw std::logic_error(
+            "Expansion order must be between 1 and " + std::to_string(MAX_ORDER));
+    this->order = order;
+    touch();
+
+    const std::uint32_t width = order + 1;
+    binomial.assign(width * width, 0.0);
+    for (std::uint32_t n = 0; n <= order; ++n) {
+        binomial[n * width] = 1.0;
+        for (std::uint32_t k = 1; k <= n; ++k)
+            binomial[n * width + k]
+                = binomial[(n - 1) * width + k - 1] + (k < n ? binomial[(n - 1) * width + k] : 0.0);
+    }
+
+    halfBinomial.assign(width * width, 0.0);
+    for (std::uint32_t k = 0; k <= order; ++k) {
+        halfBinomial[k * width] = 1.0;
+        for (std::uint32_t n = 1; n <= order; ++n)
+            halfBinomial[k * width + n] = halfBinomial[k * width + n - 1]
+                * -(static_cast<double>(k) + 0.5 + static_cast<double>(n - 1))
+                / static_cast<double>(n);
+    }
+
+    sqrtSeries.assign(width, 1.0);
+    for (std::uint32_t k = 1; k <= order; ++k)
+        sqrtSeries[k] = sqrtSeries[k - 1] * (2.0 * k - 1.0) / (2.0 * k);
+}
+
+[[nodiscard]] std::uint32_t FmmSolver::getOrder() const noexcept
+{
+    return order;
+}
+
+void FmmSolver::setTolerance(double tolerance)
+{
+    if (!(tolerance > 0.0 && tolerance < 1.0))
+        throw std::logic_error("Tolerance must be between 0 and 1");
+    const auto wanted
+        = static_cast<std::uint32_t>(std::ceil(std::log(tolerance) / std::log(CONVERGENCE)));
+    setOrder(std::clamp(wanted, 1u, MAX_ORDER));
+}
+
+void FmmSolver::setLeafSize(std::uint32_t bodies)
+{
+    if (bodies == 0)
+        throw std::logic_error("Leaf size must be positive");
+    leafSize = bodies;
+    touch();
+}
+
+[[nodiscard]] std::uint32_t FmmSolver::getLeafSize() const noexcept
+{
+    return leafSize;
+}
+
+[[nodiscard]] std::uint32_t FmmSolver::getDepth() const noexcept
+{
+    return levels.empty() ? 0 : static_cast<std::uint32_t>(levels.size() - 1);
+}
+
+void FmmSolver::accumulate(const BodyStore& bodies, const Axes& acc)
+{
+    double* ax = acc[0];
+    double* ay = acc[1];
+    if (bodies.size() == 0)
+        return;
+    buildTree(bodies);
+    upwardPass();
+    downwardPass();
+    evaluate();
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        const std::uint32_t slot = keys[i].second;
+        ax[slot] = sortedAx[i];
+        ay[slot] = sortedAy[i];
+    }
+    ax[0] = 0.0;
+    ay[0] = 0.0;
+}
+
+void FmmSolver::forEachCell(std::size_t count, const ThreadPool::RangeTask& task)
+{
+    if (isParallel()) {
+        ThreadPool& pool = *getThreadPool();
+        scratch.resize(pool.getWorkerCount());
+        pool.parallelFor(count, task, 1);
+    } else {
+        scratch.resize(1);
+        task(0, count, 0);
+    }
+}
+
+[[nodiscard]] std::size_t FmmSolver::terms() const noexcept
+{
+    return static_cast<std::size_t>(order + 1) * (order + 2) / 2;
+}
+
+[[nodiscard]] std::size_t FmmSolver::index(std::uint32_t k, std::uint32_t l) const noexcept
+{
+    // Row k of the triangle holds the order + 1 - k coefficients [k][0..order - k]
+    return static_cast<std::size_t>(k) * (order + 1) - static_cast<std::size_t>(k) * (k - 1) / 2
+        + l;
+}
+
+[[nodiscard]] FmmSolver::Complex FmmSolver::center(
+    const Level& level, const Cell& cell) const noexcept
+{
+    const auto ix = static_cast<double>(morton::compactBits(cell.key));
+    const auto iy = static_cast<double>(morton::compactBits(cell.key >> 1));
+    return { originX + (ix + 0.5) * level.width, originY + (iy + 0.5) * level.width };
+}
+
+void FmmSolver::buildTree(const BodyStore& bodies)
+{
+    const std::size_t count = bodies.size();
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* mass = bodies.activeMass();
+
+    const auto [minX, maxX] = std::minmax_element(x, x + count);
+    const auto [minY, maxY] = std::minmax_element(y, y + count);
+    double size = std::max(*maxX - *minX, *maxY - *minY);
+    if (size == 0.0)
+        size = 1.0;
+    const double scale = morton::GRID / size;
+    originX = *minX;
+    originY = *minY;
+
+    keys.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto qx = static_cast<std::uint64_t>((x[i] - originX) * scale);
+        const auto qy = static_cast<std::uint64_t>((y[i] - originY) * scale);
+        keys[i] = { morton::encode(qx, qy), static_cast<std::uint32_t>(i) };
+    }
+    std::sort(keys.begin(), keys.end());
+
+    sortedX.resize(count);
+    sortedY.resize(count);
+    sortedMass.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t slot = keys[i].second;
+        sortedX[i] = x[slot];
+        sortedY[i] = y[slot];
+        sortedMass[i] = mass[slot];
+    }
+
+    // Shallowest depth whose occupied leaves hold at most leafSize bodies on average
+    std::uint32_t depth = MIN_DEPTH;
+    for (; depth < MAX_DEPTH; ++depth) {
+        const std::uint32_t shift = 2 * (morton::BITS - depth);
+        std::size_t occupied = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i == 0 || (keys[i].first >> shift) != (keys[i - 1].first >> shift))
+                ++occupied;
+        }
+        if (count <= occupied * leafSize)
+            break;
+    }
+
+    levels.resize(depth + 1);
+    for (std::uint32_t l = 0; l <= depth; ++l) {
+        Level& level = levels[l];
+        level.width = std::ldexp(1.0, static_cast<int>(morton::BITS - l)) / scale;
+        level.cells.clear();
+        level.lookup.clear();
+    }
+
+    // Leaves straight from the sorted keys, coarser levels by merging siblings
+    const std::uint32_t shift = 2 * (morton::BITS - depth);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint64_t key = keys[i].first >> shift;
+        auto& cells = levels[depth].cells;
+        if (cells.empty() || cells.back().key != key)
+            cells.push_back(Cell { key, static_cast<std::uint32_t>(i), 0 });
+        cells.back().end = static_cast<std::uint32_t>(i + 1);
+    }
+    for (std::uint32_t l = depth; l > MIN_DEPTH; --l) {
+        auto& parents = levels[l - 1].cells;
+        for (const Cell& child : levels[l].cells) {
+            if (parents.empty() || parents.back().key != child.key >> 2)
+                parents.push_back(Cell { child.key >> 2, child.begin, child.end });
+            parents.back().end = child.end;
+        }
+    }
+
+    const std::size_t n = terms();
+    for (std::uint32_t l = MIN_DEPTH; l <= depth; ++l) {
+        Level& level = levels[l];
+        level.lookup.reserve(level.cells.size());
+        for (std::uint32_t c = 0; c < level.cells.size(); ++c)
+            level.lookup.emplace(level.cells[c].key, c);
+        level.multipole.assign(level.cells.size() * n, Complex());
+        level.local.assign(level.cells.size() * n, Complex());
+    }
+}
+
+void FmmSolver::upwardPass()
+{
+    const std::size_t n = terms();
+    const std::uint32_t depth = getDepth();
+    std::vector<Complex> powersB(order + 1);
+
+    // P2M: moments of the bodies about the leaf centers, in units of the leaf width
+    Level& leaves = levels[depth];
+    for (std::size_t c = 0; c < leaves.cells.size(); ++c) {
+        const Cell& cell = leaves.cells[c];
+        const Complex mid = center(leaves, cell);
+        Complex* moments = &leaves.multipole[c * n];
+        for (std::uint32_t i = cell.begin; i < cell.end; ++i) {
+            const Complex b = (Complex(sortedX[i], sortedY[i]) - mid) / leaves.width;
+            powers(b, order + 1, powersB.data());
+            for (std::uint32_t k = 0; k <= order; ++k) {
+                const Complex weighted = sortedMass[i] * powersB[k];
+                for (std::uint32_t l = 0; k + l <= order; ++l)
+                    moments[index(k, l)] += weighted * std::conj(powersB[l]);
+            }
+        }
+    }
+
+    // M2M: shift every child's moments to its parent's center and scale
+    std::vector<Complex> powersS(order + 1);
+    std::vector<double> powersRho(order + 1);
+    for (std::uint32_t i = 0; i <= order; ++i)
+        powersRho[i] = std::ldexp(1.0, -static_cast<int>(i));
+    for (std::uint32_t l = depth; l > MIN_DEPTH; --l) {
+        Level& children = levels[l];
+        Level& parents = levels[l - 1];
+        for (std::size_t c = 0; c < children.cells.size(); ++c) {
+            const Cell& child = children.cells[c];
+            const std::uint32_t p = parents.lookup.at(child.key >> 2);
+            const Complex s
+                = (center(children, child) - center(parents, parents.cells[p])) / parents.width;
+            powers(s, order + 1, powersS.data());
+            const Complex* from = &children.multipole[c * n];
+            Complex* to = &parents.multipole[p * n];
+            for (std::uint32_t k = 0; k <= order; ++k) {
+                for (std::uint32_t m = 0; k + m <= order; ++m) {
+                    Complex sum;
+                    for (std::uint32_t i = 0; i <= k; ++i) {
+                        const Complex left = binomial[k * (order + 1) + i] * powersS[k - i];
+                        for (std::uint32_t j = 0; j <= m; ++j)
+                            sum += left * binomial[m * (order + 1) + j] * std::conj(powersS[m - j])
+                                * powersRho[i + j] * from[index(i, j)];
+                    }
+                    to[index(k, m)] += sum;
+                }
+            }
+        }
+    }
+}
+
+void FmmSolver::multipoleToLocal(const Complex* source, Complex offset, double width,
+    Complex* target, std::vector<Complex>& work) const
+{
+    const std::uint32_t width1 = order + 1;
+    const Complex u = width / offset;
+    const double inverseDistance = 1.0 / std::abs(offset);
+
+    std::vector<Complex>& powersU = work;
+    powersU.resize(2 * width1 + width1 * width1);
+    Complex* powersV = powersU.data() + width1; // powers of conj(u)
+    Complex* partial = powersV + width1; // partial[k * width1 + m]
+    powers(u, width1, powersU.data());
+    powers(std::conj(u), width1, powersV);
+
+    // partial[k][m] = sum over l of (-l - 1/2 choose m) Q[k][l] u^k conj(u)^l
+    for (std::uint32_t k = 0; k <= order; ++k) {
+        for (std::uint32_t m = 0; m <= order; ++m) {
+            Complex sum;
+            for (std::uint32_t l = 0; k + l <= order; ++l)
+                sum += halfBinomial[l * width1 + m] * sqrtSeries[l] * powersV[l]
+                    * source[index(k, l)];
+            partial[k * width1 + m] = sum * sqrtSeries[k] * powersU[k];
+        }
+    }
+
+    // L[n][m] += |D|^-1 u^n conj(u)^m sum over k of (-k - 1/2 choose n) partial[k][m]
+    for (std::uint32_t n = 0; n <= order; ++n) {
+        for (std::uint32_t m = 0; n + m <= order; ++m) {
+            Complex sum;
+            for (std::uint32_t k = 0; k <= order; ++k)
+                sum += halfBinomial[k * width1 + n] * partial[k * width1 + m];
+            target[index(n, m)] += inverseDistance * powersU[n] * powersV[m] * sum;
+        }
+    }
+}
+
+void FmmSolver::downwardPass()
+{
+    const std::size_t n = terms();
+    const std::uint32_t depth = getDepth();
+    std::vector<double> powersRho(order + 1);
+    for (std::uint32_t i = 0; i <= order; ++i)
+        powersRho[i] = std::ldexp(1.0, -static_cast<int>(i));
+
+    for (std::uint32_t l = MIN_DEPTH; l <= depth; ++l) {
+        Level& level = levels[l];
+        const auto side = static_cast<std::int64_t>(1) << l;
+        // Every cell only writes its own local expansion
+        auto translate = [&](std::size_t begin, std::size_t end, std::size_t worker) {
+            std::vector<Complex> powersS(order + 1);
+            for (std::size_t c = begin; c < end; ++c) {
+                const Cell& cell = level.cells[c];
+                const Complex mid = center(level, cell);
+                Complex* local = &level.local[c * n];
+
+                // L2L: re-expand the parent's local expansion about this cell's center
+                if (l > MIN_DEPTH) {
+                    Level& parents = levels[l - 1];
+                    const std::uint32_t p = parents.lookup.at(cell.key >> 2);
+                    const Complex s = (mid - center(parents, parents.cells[p])) / parents.width;
+                    powers(s, order + 1, powersS.data());
+                    const Complex* from = &parents.local[p * n];
+                    for (std::uint32_t i = 0; i <= order; ++i) {
+                        for (std::uint32_t j = 0; i + j <= order; ++j) {
+                            Complex sum;
+                            for (std::uint32_t a = i; a <= order; ++a) {
+                                const Complex left = binomial[a * (order + 1) + i] * powersS[a - i];
+                                for (std::uint32_t b = j; a + b <= order; ++b)
+                                    sum += left * binomial[b * (order + 1) + j]
+                                        * std::conj(powersS[b - j]) * from[index(a, b)];
+                            }
+                            local[index(i, j)] += powersRho[i + j] * sum;
+                        }
+                    }
+                }
+
+                // M2L: children of the parent's neighbours that are not adjacent to this cell
+                const auto ix = static_cast<std::int64_t>(morton::compactBits(cell.key));
+                const auto iy = static_cast<std::int64_t>(morton::compactBits(cell.key >> 1));
+                for (std::int64_t nx = (ix / 2 - 1) * 2; nx < (ix / 2 + 2) * 2; ++nx) {
+                    for (std::int64_t ny = (iy / 2 - 1) * 2; ny < (iy / 2 + 2) * 2; ++ny) {
+                        if (nx < 0 || ny < 0 || nx >= side || ny >= side)
+                            continue;
+                        if (std::abs(nx - ix) <= 1 && std::abs(ny - iy) <= 1)
+                            continue;
+                        const auto found = level.lookup.find(morton::encode(
+                            static_cast<std::uint64_t>(nx), static_cast<std::uint64_t>(ny)));
+                        if (found == level.lookup.end())
+                            continue;
+                        const Complex other = center(level, level.cells[found->second]);
+                        multipoleToLocal(
+                            &level.multipole[found->second * n], mid - other, level.width, local,
+                            scratch[worker]);
+                    }
+                }
+            }
+        };
+        forEachCell(level.cells.size(), translate);
+    }
+}
+
+void FmmSolver::evaluate()
+{
+    const std::size_t n = terms();
+    const Level& leaves = levels[getDepth()];
+    const auto side = static_cast<std::int64_t>(1) << getDepth();
+    sortedAx.resize(keys.size());
+    sortedAy.resize(keys.size());
+
+    // Every leaf only writes the accelerations of its own sorted bodies
+    auto evaluateLeaves = [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::vector<Complex> powersT(order + 1);
+        std::vector<const Cell*> near;
+        for (std::size_t c = begin; c < end; ++c) {
+            const Cell& cell = leaves.cells[c];
+            const Complex mid = center(leaves, cell);
+            const Complex* local = &leaves.local[c * n];
+
+            // Adjacent leaves (and this one) are summed directly
+            near.clear();
+            const auto ix = static_cast<std::int64_t>(morton::compactBits(cell.key));
+            const auto iy = static_cast<std::int64_t>(morton::compactBits(cell.key >> 1));
+            for (std::int64_t nx = ix - 1; nx <= ix + 1; ++nx) {
+                for (std::int64_t ny = iy - 1; ny <= iy + 1; ++ny) {
+                    if (nx < 0 || ny < 0 || nx >= side || ny >= side)
+                        continue;
+                    const auto found = leaves.lookup.find(morton::encode(
+                        static_cast<std::uint64_t>(nx), static_cast<std::uint64_t>(ny)));
+                    if (found != leaves.lookup.end())
+                        near.push_back(&leaves.cells[found->second]);
+                }
+            }
+
+            for (std::uint32_t i = cell.begin; i < cell.end; ++i) {
+                // Far field: 2 dPhi/d(conj t) of the local expansion
+                const Complex t = (Complex(sortedX[i], sortedY[i]) - mid) / leaves.width;
+                powers(t, order + 1, powersT.data());
+                Complex far;
+                for (std::uint32_t a = 0; a < order; ++a) {
+                    for (std::uint32_t b = 1; a + b <= order; ++b)
+                        far += static_cast<double>(b) * local[index(a, b)] * powersT[a]
+                            * std::conj(powersT[b - 1]);
+                }
+                far *= 2.0 * Universe::G / leaves.width;
+
+                double sumX = far.real();
+                double sumY = far.imag();
+                for (const Cell* other : near) {
+                    for (std::uint32_t j = other->begin; j < other->end; ++j) {
+                        const double dx = sortedX[j] - sortedX[i];
+                        const double dy = sortedY[j] - sortedY[i];
+                        const double disSq = dx * dx + dy * dy;
+                        // Coincident bodies (including i itself) exert no force
+                        if (disSq == 0.0)
+                            continue;
+                        const double scale
+                            = Universe::G * sortedMass[j] / (disSq * std::sqrt(disSq));
+                        sumX += scale * dx;
+                        sumY += scale * dy;
+                    }
+                }
+                sortedAx[i] = sumX;
+                sortedAy[i] = sumY;
+            }
+        }
+    };
+    forEachCell(leaves.cells.size(), evaluateLeaves);
+}
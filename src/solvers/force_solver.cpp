@@ -0,0 +1,141 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/force_solver.h"
+
+#include "body_store.h"
+#include "solvers/direct_solver.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+
+template <uint32_t DIM>
+void BasicForceSolver<DIM>::computeAccelerations(
+    const BasicBodyStore<DIM>& bodies, const Axes& acc)
+{
+    accumulate(bodies, acc);
+    if (!validation)
+        return;
+
+    const std::size_t count = bodies.size();
+    Axes ref;
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        reference[axis].assign(count, 0.0);
+        ref[axis] = reference[axis].data();
+    }
+    BasicDirectSolver<DIM> direct;
+    BasicForceSolver<DIM>& exact = direct;
+    exact.accumulate(bodies, ref);
+
+    ForceError error;
+    std::size_t samples = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        double refSq = 0.0;
+        double diffSq = 0.0;
+        for (uint32_t axis = 0; axis < DIM; ++axis) {
+            const double diff = acc[axis][i] - ref[axis][i];
+            refSq += ref[axis][i] * ref[axis][i];
+            diffSq += diff * diff;
+        }
+        if (refSq == 0.0)
+            continue;
+        const double relative = std::sqrt(diffSq / refSq);
+        error.maxRelative = std::max(error.maxRelative, relative);
+        error.rmsRelative += relative * relative;
+        ++samples;
+    }
+    if (samples > 0)
+        error.rmsRelative = std::sqrt(error.rmsRelative / static_cast<double>(samples));
+    lastError = error;
+}
+
+template <uint32_t DIM>
+void BasicForceSolver<DIM>::computeAccelerations(
+    const BasicBodyStore<DIM>& bodies, double* ax, double* ay)
+    requires(DIM == 2)
+{
+    computeAccelerations(bodies, Axes { ax, ay });
+}
+
+template <uint32_t DIM> void BasicForceSolver<DIM>::setValidation(bool enabled) noexcept
+{
+    validation = enabled;
+}
+
+template <uint32_t DIM> [[nodiscard]] bool BasicForceSolver<DIM>::getValidation() const noexcept
+{
+    return validation;
+}
+
+template <uint32_t DIM>
+[[nodiscard]] const ForceError& BasicForceSolver<DIM>::getLastError() const noexcept
+{
+    return lastError;
+}
+
+template <uint32_t DIM>
+ForceError BasicForceSolver<DIM>::validate(const BasicBodyStore<DIM>& bodies)
+{
+    std::array<std::vector<double>, DIM> result;
+    Axes acc;
+    for (uint32_t axis = 0; axis < DIM; ++axis) {
+        result[axis].resize(bodies.size());
+        acc[axis] = result[axis].data();
+    }
+    const bool wasEnabled = validation;
+    validation = true;
+    probing = true;
+    computeAccelerations(bodies, acc);
+    probing = false;
+    validation = wasEnabled;
+    return lastError;
+}
+
+template <uint32_t DIM> void BasicForceSolver<DIM>::setDeterministic(bool enabled) noexcept
+{
+    deterministic = enabled;
+    touch();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] bool BasicForceSolver<DIM>::getDeterministic() const noexcept
+{
+    return deterministic;
+}
+
+template <uint32_t DIM> void BasicForceSolver<DIM>::setThreadPool(ThreadPool* pool) noexcept
+{
+    this->pool = pool;
+    // Without the deterministic mode the summation order follows the workers
+    touch();
+}
+
+template <uint32_t DIM>
+[[nodiscard]] ThreadPool* BasicForceSolver<DIM>::getThreadPool() const noexcept
+{
+    return pool;
+}
+
+template <uint32_t DIM> [[nodiscard]] bool BasicForceSolver<DIM>::isParallel() const noexcept
+{
+    return pool && pool->getWorkerCount() > 1;
+}
+
+template <uint32_t DIM> [[nodiscard]] bool BasicForceSolver<DIM>::isProbing() const noexcept
+{
+    return probing;
+}
+
+template <uint32_t DIM>
+[[nodiscard]] std::uint64_t BasicForceSolver<DIM>::getGeneration() const noexcept
+{
+    return generation;
+}
+
+template <uint32_t DIM> void BasicForceSolver<DIM>::touch() noexcept
+{
+    ++generation;
+}
+
+template class BasicForceSolver<2>;
+template class BasicForceSolver<3>;
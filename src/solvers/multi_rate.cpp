@@ -0,0 +1,154 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/multi_rate.h"
+
+#include "body_store.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+MultiRateSolver::MultiRateSolver(std::size_t interval, double nearFactor, double drift)
+    : CachedRowSolver(interval)
+    , nearFactor(0.0)
+    , drift(0.0)
+{
+    setNearFactor(nearFactor);
+    setDrift(drift);
+}
+
+void MultiRateSolver::setNearFactor(double nearFactor)
+{
+    if (!(nearFactor >= 0.0))
+        throw std::logic_error("Near factor must not be negative");
+    this->nearFactor = nearFactor;
+    // The split changes, so the cached slow pulls are no longer valid
+    invalidate();
+    touch();
+}
+
+[[nodiscard]] double MultiRateSolver::getNearFactor() const noexcept
+{
+    return nearFactor;
+}
+
+void MultiRateSolver::setDrift(double drift)
+{
+    if (!(drift >= 0.0))
+        throw std::logic_error("Drift threshold must not be negative");
+    this->drift = drift;
+    invalidate();
+    touch();
+}
+
+[[nodiscard]] double MultiRateSolver::getDrift() const noexcept
+{
+    return drift;
+}
+
+void MultiRateSolver::resize(std::size_t count)
+{
+    slowX.resize(count);
+    slowY.resize(count);
+    closestSq.resize(count);
+}
+
+void MultiRateSolver::refreshRow(
+    const BodyStore& bodies, std::size_t i, bool keep, double* ax, double* ay)
+{
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* mass = bodies.activeMass();
+    const double rx = x[i] - x[0];
+    const double ry = y[i] - y[0];
+    const double nearSq = nearFactor * nearFactor * (rx * rx + ry * ry);
+    std::vector<std::uint32_t>* row = keep ? &lists[i] : nullptr;
+    if (row)
+        row->clear();
+    double fastX = 0.0;
+    double fastY = 0.0;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double closest = std::numeric_limits<double>::infinity();
+    for (const std::uint32_t j : bodies.getSources()) {
+        if (j == i)
+            continue;
+        const double dx = x[j] - x[i];
+        const double dy = y[j] - y[i];
+        const double disSq = dx * dx + dy * dy;
+        // The sun dominates every target and is always fast, so are coincident
+        // bodies, which pull on nobody until they separate
+        if (j == 0 || disSq < nearSq || disSq == 0.0) {
+            if (row)
+                row->push_back(j);
+            if (disSq == 0.0)
+                continue;
+            const double scale = Universe::G / (disSq * std::sqrt(disSq));
+            fastX += mass[j] * scale * dx;
+            fastY += mass[j] * scale * dy;
+            continue;
+        }
+        const double scale = Universe::G / (disSq * std::sqrt(disSq));
+        sumX += mass[j] * scale * dx;
+        sumY += mass[j] * scale * dy;
+        closest = std::min(closest, disSq);
+    }
+    if (keep) {
+        slowX[i] = sumX;
+        slowY[i] = sumY;
+        closestSq[i] = closest;
+    }
+    ax[i] = fastX + sumX;
+    ay[i] = fastY + sumY;
+}
+
+void MultiRateSolver::reuseRow(
+    const BodyStore& bodies, std::size_t i, double* ax, double* ay) const
+{
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* mass = bodies.activeMass();
+    double fastX = 0.0;
+    double fastY = 0.0;
+    for (const std::uint32_t j : lists[i]) {
+        const double dx = x[j] - x[i];
+        const double dy = y[j] - y[i];
+        const double disSq = dx * dx + dy * dy;
+        if (disSq == 0.0)
+            continue;
+        const double scale = Universe::G / (disSq * std::sqrt(disSq));
+        fastX += mass[j] * scale * dx;
+        fastY += mass[j] * scale * dy;
+    }
+    ax[i] = fastX + slowX[i];
+    ay[i] = fastY + slowY[i];
+}
+
+[[nodiscard]] bool MultiRateSolver::hasDrifted(const BodyStore& bodies) const
+{
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        const double dx = x[i] - anchorX[i];
+        const double dy = y[i] - anchorY[i];
+        if (dx * dx + dy * dy > limitSq)
+            return true;
+    }
+    return false;
+}
+
+void MultiRateSolver::finish(const BodyStore& bodies, bool refreshed)
+{
+    if (!refreshed)
+        return;
+    const std::size_t count = bodies.size();
+    anchorX.assign(bodies.x(), bodies.x() + count);
+    anchorY.assign(bodies.y(), bodies.y() + count);
+    // Both ends of the closest slow pair may move, each by at most drift times its separation
+    double closest = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 1; i < count; ++i)
+        closest = std::min(closest, closestSq[i]);
+    limitSq = std::isinf(closest) ? closest : drift * drift * closest;
+}
@@ -0,0 +1,121 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/pruned_solver.h"
+
+#include "body_store.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+PrunedSolver::PrunedSolver(double threshold, std::size_t interval)
+    : CachedRowSolver(interval)
+    , threshold(0.0)
+{
+    setThreshold(threshold);
+}
+
+void PrunedSolver::setThreshold(double threshold)
+{
+    if (!(threshold >= 0.0))
+        throw std::logic_error("Pruning threshold must not be negative");
+    this->threshold = threshold;
+    // The lists were pruned with the old cutoff
+    invalidate();
+    touch();
+}
+
+[[nodiscard]] double PrunedSolver::getThreshold() const noexcept
+{
+    return threshold;
+}
+
+void PrunedSolver::resize(std::size_t count)
+{
+    droppedPull.resize(count);
+    sunPull.resize(count);
+}
+
+void PrunedSolver::refreshRow(
+    const BodyStore& bodies, std::size_t i, bool keep, double* ax, double* ay)
+{
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* mass = bodies.activeMass();
+    const double rx = x[0] - x[i];
+    const double ry = y[0] - y[i];
+    const double sunSq = rx * rx + ry * ry;
+    // A source is kept if mass[j] / d^2 >= threshold * mass[0] / r^2
+    const double cutoff = sunSq > 0.0 ? threshold * mass[0] / sunSq : 0.0;
+    std::vector<std::uint32_t>* list = keep ? &lists[i] : nullptr;
+    if (list)
+        list->clear();
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double dropped = 0.0;
+    for (const std::uint32_t j : bodies.getSources()) {
+        if (j == i)
+            continue;
+        const double dx = x[j] - x[i];
+        const double dy = y[j] - y[i];
+        const double disSq = dx * dx + dy * dy;
+        // Coincident bodies pull on nobody until they separate, so they are kept
+        if (j == 0 || disSq == 0.0 || mass[j] >= cutoff * disSq) {
+            if (list)
+                list->push_back(j);
+            if (disSq == 0.0)
+                continue;
+            const double scale = Universe::G / (disSq * std::sqrt(disSq));
+            sumX += mass[j] * scale * dx;
+            sumY += mass[j] * scale * dy;
+            continue;
+        }
+        // Magnitudes add up to a bound that holds whatever the directions
+        dropped += Universe::G * mass[j] / disSq;
+    }
+    if (keep) {
+        droppedPull[i] = dropped;
+        sunPull[i] = sunSq > 0.0 ? Universe::G * mass[0] / sunSq : 0.0;
+    }
+    ax[i] = sumX;
+    ay[i] = sumY;
+}
+
+void PrunedSolver::reuseRow(
+    const BodyStore& bodies, std::size_t i, double* ax, double* ay) const
+{
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* mass = bodies.activeMass();
+    double sumX = 0.0;
+    double sumY = 0.0;
+    for (const std::uint32_t j : lists[i]) {
+        const double dx = x[j] - x[i];
+        const double dy = y[j] - y[i];
+        const double disSq = dx * dx + dy * dy;
+        if (disSq == 0.0)
+            continue;
+        const double scale = Universe::G / (disSq * std::sqrt(disSq));
+        sumX += mass[j] * scale * dx;
+        sumY += mass[j] * scale * dy;
+    }
+    ax[i] = sumX;
+    ay[i] = sumY;
+}
+
+void PrunedSolver::finish(const BodyStore& bodies, bool refreshed)
+{
+    if (refreshed) {
+        neglected = 0.0;
+        stats.neglectedRelative = 0.0;
+        for (std::size_t i = 1; i < bodies.size(); ++i) {
+            neglected = std::max(neglected, droppedPull[i]);
+            if (sunPull[i] > 0.0) {
+                stats.neglectedRelative
+                    = std::max(stats.neglectedRelative, droppedPull[i] / sunPull[i]);
+            }
+        }
+    }
+    stats.neglectedSum += neglected;
+}
@@ -0,0 +1,524 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "solvers/simd_solver.h"
+
+#include "body_store.h"
+#include "thread_pool.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_SOLVER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t TILE = 2048; // Sources per tile, 48KB of x, y and pull
+constexpr std::size_t BLOCK = 16; // Targets per parallel block, whole registers of every kernel
+constexpr std::size_t MIXED_GROUP = 256; // Targets sharing a local origin, whole BLOCKs
+constexpr std::size_t MIXED_TILE = 512; // Sources re-based at a time, 10KB of offsets and pull
+constexpr std::size_t MIXED_RUN = 64; // Sources summed in float before the sum is widened
+
+/**
+ * Adds the pull of sources [first, last) onto targets [begin, end). Sources are
+ * gathered into sx, sy and pull, targets are read from x and y
+ */
+void tileScalar(const double* x, const double* y, const double* sx, const double* sy,
+    const double* pull, std::size_t first, std::size_t last, std::size_t begin, std::size_t end,
+    double* ax, double* ay)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        double sumX = ax[i];
+        double sumY = ay[i];
+        for (std::size_t j = first; j < last; ++j) {
+            const double dx = sx[j] - x[i];
+            const double dy = sy[j] - y[i];
+            const double disSq = dx * dx + dy * dy;
+            // Coincident bodies (including i itself) exert no force
+            if (disSq == 0.0)
+                continue;
+            const double scale = pull[j] / (disSq * std::sqrt(disSq));
+            sumX += scale * dx;
+            sumY += scale * dy;
+        }
+        ax[i] = sumX;
+        ay[i] = sumY;
+    }
+}
+
+/**
+ * Bodies relative to a local origin, scaled by a power of two. Every offset is
+ * split into its nearest float and the float of the remainder, so hi + lo
+ * keeps about 48 bits and close pairs far from the origin stay resolved.
+ */
+template <std::size_t N> struct Rebased {
+    float hiX[N]; // x offsets rounded to float
+    float loX[N]; // Remainders of the x offsets
+    float hiY[N]; // y offsets rounded to float
+    float loY[N]; // Remainders of the y offsets
+};
+
+typedef Rebased<MIXED_GROUP> MixedTargets;
+typedef Rebased<MIXED_TILE> MixedSources;
+
+/**
+ * Stores an offset as a float and the float of its remainder
+ */
+inline void splitOffset(double offset, float& hi, float& lo)
+{
+    hi = static_cast<float>(offset);
+    lo = static_cast<float>(offset - static_cast<double>(hi));
+}
+
+/**
+ * Mixed precision version of tileScalar for the count targets of a group from
+ * lane on. Every pair is computed in float from the split offsets, every run
+ * of MIXED_RUN sources is summed in float and then added to the double sums ax
+ * and ay of the group
+ */
+void blockScalarMixed(const MixedTargets& t, std::size_t lane, std::size_t count,
+    const MixedSources& s, const float* pull, std::size_t sourceCount, double* ax, double* ay)
+{
+    for (std::size_t i = lane; i < lane + count; ++i) {
+        for (std::size_t first = 0; first < sourceCount; first += MIXED_RUN) {
+            const std::size_t last = std::min(first + MIXED_RUN, sourceCount);
+            float runX = 0.0f;
+            float runY = 0.0f;
+            for (std::size_t j = first; j < last; ++j) {
+                const float dx = (s.hiX[j] - t.hiX[i]) + (s.loX[j] - t.loX[i]);
+                const float dy = (s.hiY[j] - t.hiY[i]) + (s.loY[j] - t.loY[i]);
+                const float disSq = dx * dx + dy * dy;
+                if (disSq == 0.0f)
+                    continue;
+                // The offsets lie in [-1, 1] and hi + lo resolves about 2^-48 of
+                // them, but the inverse cube overflows a float for pairs closer
+                // than about 2^-43 of the local extent, which then pull infinitely
+                const float inv = 1.0f / std::sqrt(disSq);
+                const float scale = pull[j] * inv * (inv * inv);
+                runX += scale * dx;
+                runY += scale * dy;
+            }
+            ax[i] += static_cast<double>(runX);
+            ay[i] += static_cast<double>(runY);
+        }
+    }
+}
+
+#ifdef SIMD_SOLVER_X86
+
+/**
+ * One Newton step towards 1 / sqrt(disSq), doubles the number of correct bits
+ * @param inv - current estimate
+ * @param half - disSq / 2
+ */
+[[gnu::target("avx2,fma")]] inline __m256d refineAvx2(__m256d inv, __m256d half)
+{
+    const __m256d residual = _mm256_fnmadd_pd(half, _mm256_mul_pd(inv, inv), _mm256_set1_pd(1.5));
+    return _mm256_mul_pd(inv, residual);
+}
+
+/**
+ * AVX2 version of tileScalar, returns the first target it did not handle. The
+ * float estimate of 1 / sqrt(disSq) has 12 correct bits and two Newton steps
+ * bring it within 1e-13, which is much cheaper than a division and a square
+ * root. disSq is scaled by 2^-64 on the way to float, so separations from
+ * 5e-10 m to 8e28 m stay within its range; the estimate stays scaled and the
+ * pull makes up for it.
+ */
+[[gnu::target("avx2,fma")]] std::size_t tileAvx2(const double* x, const double* y,
+    const double* sx, const double* sy, const double* pull, std::size_t first, std::size_t last,
+    std::size_t begin, std::size_t end, double* ax, double* ay)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d scaleDown = _mm256_set1_pd(0x1p-64);
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m256d xi = _mm256_loadu_pd(x + i);
+        const __m256d yi = _mm256_loadu_pd(y + i);
+        __m256d sumX = _mm256_loadu_pd(ax + i);
+        __m256d sumY = _mm256_loadu_pd(ay + i);
+        for (std::size_t j = first; j < last; ++j) {
+            const __m256d dx = _mm256_sub_pd(_mm256_set1_pd(sx[j]), xi);
+            const __m256d dy = _mm256_sub_pd(_mm256_set1_pd(sy[j]), yi);
+            const __m256d disSq = _mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy));
+            // 1 / sqrt(disSq * 2^-64) is 2^32 times the inverse distance
+            const __m256d scaled = _mm256_mul_pd(disSq, scaleDown);
+            const __m256d half = _mm256_mul_pd(_mm256_set1_pd(0.5), scaled);
+            __m256d inv = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(scaled)));
+            inv = refineAvx2(refineAvx2(inv, half), half);
+            // Lanes with coincident bodies are masked out
+            const __m256d live = _mm256_cmp_pd(disSq, zero, _CMP_NEQ_OQ);
+            const __m256d cube = _mm256_mul_pd(inv, _mm256_mul_pd(inv, inv));
+            const __m256d scale
+                = _mm256_and_pd(_mm256_mul_pd(_mm256_set1_pd(pull[j] * 0x1p-96), cube), live);
+            sumX = _mm256_fmadd_pd(scale, dx, sumX);
+            sumY = _mm256_fmadd_pd(scale, dy, sumY);
+        }
+        _mm256_storeu_pd(ax + i, sumX);
+        _mm256_storeu_pd(ay + i, sumY);
+    }
+    return i;
+}
+
+/**
+ * AVX-512 version of refineAvx2
+ */
+[[gnu::target("avx512f")]] inline __m512d refineAvx512(__m512d inv, __m512d half)
+{
+    const __m512d residual = _mm512_fnmadd_pd(half, _mm512_mul_pd(inv, inv), _mm512_set1_pd(1.5));
+    return _mm512_mul_pd(inv, residual);
+}
+
+/**
+ * AVX-512 version of tileAvx2. The hardware estimate of 1 / sqrt(disSq) has
+ * 14 correct bits, so two Newton steps are enough.
+ */
+[[gnu::target("avx512f")]] std::size_t tileAvx512(const double* x, const double* y,
+    const double* sx, const double* sy, const double* pull, std::size_t first, std::size_t last,
+    std::size_t begin, std::size_t end, double* ax, double* ay)
+{
+    const __m512d zero = _mm512_setzero_pd();
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m512d xi = _mm512_loadu_pd(x + i);
+        const __m512d yi = _mm512_loadu_pd(y + i);
+        __m512d sumX = _mm512_loadu_pd(ax + i);
+        __m512d sumY = _mm512_loadu_pd(ay + i);
+        for (std::size_t j = first; j < last; ++j) {
+            const __m512d dx = _mm512_sub_pd(_mm512_set1_pd(sx[j]), xi);
+            const __m512d dy = _mm512_sub_pd(_mm512_set1_pd(sy[j]), yi);
+            const __m512d disSq = _mm512_fmadd_pd(dx, dx, _mm512_mul_pd(dy, dy));
+            // Lanes with coincident bodies are left at zero
+            const __mmask8 live = _mm512_cmp_pd_mask(disSq, zero, _CMP_NEQ_OQ);
+            __m512d inv = _mm512_maskz_rsqrt14_pd(live, disSq);
+            const __m512d half = _mm512_mul_pd(_mm512_set1_pd(0.5), disSq);
+            inv = refineAvx512(refineAvx512(inv, half), half);
+            const __m512d cube = _mm512_mul_pd(inv, _mm512_mul_pd(inv, inv));
+            const __m512d scale = _mm512_mul_pd(_mm512_set1_pd(pull[j]), cube);
+            sumX = _mm512_fmadd_pd(scale, dx, sumX);
+            sumY = _mm512_fmadd_pd(scale, dy, sumY);
+        }
+        _mm512_storeu_pd(ax + i, sumX);
+        _mm512_storeu_pd(ay + i, sumY);
+    }
+    return i;
+}
+
+/**
+ * Mixed precision version of tileAvx2 for the 8 targets of a group from lane
+ * on. The hardware estimate of 1 / sqrt(disSq) has 12 correct bits and one
+ * Newton step brings it to float precision. Every run of MIXED_RUN sources is
+ * summed in float and then widened into the double sums ax and ay.
+ */
+[[gnu::target("avx2,fma")]] void blockAvx2Mixed(const MixedTargets& t, std::size_t lane,
+    const MixedSources& s, const float* pull, std::size_t sourceCount, double* ax, double* ay)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 hiX = _mm256_loadu_ps(t.hiX + lane);
+    const __m256 loX = _mm256_loadu_ps(t.loX + lane);
+    const __m256 hiY = _mm256_loadu_ps(t.hiY + lane);
+    const __m256 loY = _mm256_loadu_ps(t.loY + lane);
+    __m256d lowSumX = _mm256_loadu_pd(ax + lane);
+    __m256d highSumX = _mm256_loadu_pd(ax + lane + 4);
+    __m256d lowSumY = _mm256_loadu_pd(ay + lane);
+    __m256d highSumY = _mm256_loadu_pd(ay + lane + 4);
+    for (std::size_t first = 0; first < sourceCount; first += MIXED_RUN) {
+        const std::size_t last = std::min(first + MIXED_RUN, sourceCount);
+        __m256 runX = zero;
+        __m256 runY = zero;
+        for (std::size_t j = first; j < last; ++j) {
+            const __m256 dx = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(s.hiX[j]), hiX),
+                _mm256_sub_ps(_mm256_set1_ps(s.loX[j]), loX));
+            const __m256 dy = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(s.hiY[j]), hiY),
+                _mm256_sub_ps(_mm256_set1_ps(s.loY[j]), loY));
+            const __m256 disSq = _mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy));
+            const __m256 half = _mm256_mul_ps(_mm256_set1_ps(0.5f), disSq);
+            __m256 inv = _mm256_rsqrt_ps(disSq);
+            inv = _mm256_mul_ps(
+                inv, _mm256_fnmadd_ps(half, _mm256_mul_ps(inv, inv), _mm256_set1_ps(1.5f)));
+            // Lanes with coincident bodies are masked out
+            const __m256 live = _mm256_cmp_ps(disSq, zero, _CMP_NEQ_OQ);
+            const __m256 scale = _mm256_and_ps(
+                _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(pull[j]), inv), _mm256_mul_ps(inv, inv)),
+                live);
+            runX = _mm256_fmadd_ps(scale, dx, runX);
+            runY = _mm256_fmadd_ps(scale, dy, runY);
+        }
+        lowSumX = _mm256_add_pd(lowSumX, _mm256_cvtps_pd(_mm256_castps256_ps128(runX)));
+        highSumX = _mm256_add_pd(highSumX, _mm256_cvtps_pd(_mm256_extractf128_ps(runX, 1)));
+        lowSumY = _mm256_add_pd(lowSumY, _mm256_cvtps_pd(_mm256_castps256_ps128(runY)));
+        highSumY = _mm256_add_pd(highSumY, _mm256_cvtps_pd(_mm256_extractf128_ps(runY, 1)));
+    }
+    _mm256_storeu_pd(ax + lane, lowSumX);
+    _mm256_storeu_pd(ax + lane + 4, highSumX);
+    _mm256_storeu_pd(ay + lane, lowSumY);
+    _mm256_storeu_pd(ay + lane + 4, highSumY);
+}
+
+/**
+ * Widens the 16 float lanes of run to double and adds them to low (lanes 0
+ * to 7) and high (lanes 8 to 15)
+ */
+[[gnu::target("avx512f")]] inline void widenAvx512(__m512 run, __m512d& low, __m512d& high)
+{
+    const __m512d bits = _mm512_castps_pd(run);
+    const __m256 lower = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xf, bits, 0));
+    const __m256 upper = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xf, bits, 1));
+    low = _mm512_add_pd(low, _mm512_maskz_cvtps_pd(0xff, lower));
+    high = _mm512_add_pd(high, _mm512_maskz_cvtps_pd(0xff, upper));
+}
+
+/**
+ * Mixed precision version of tileAvx512 for the 16 targets of a group from
+ * lane on. The hardware estimate of 1 / sqrt(disSq) has 14 correct bits, one
+ * Newton step is enough.
+ */
+[[gnu::target("avx512f")]] void blockAvx512Mixed(const MixedTargets& t, std::size_t lane,
+    const MixedSources& s, const float* pull, std::size_t sourceCount, double* ax, double* ay)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 hiX = _mm512_loadu_ps(t.hiX + lane);
+    const __m512 loX = _mm512_loadu_ps(t.loX + lane);
+    const __m512 hiY = _mm512_loadu_ps(t.hiY + lane);
+    const __m512 loY = _mm512_loadu_ps(t.loY + lane);
+    __m512d lowSumX = _mm512_loadu_pd(ax + lane);
+    __m512d highSumX = _mm512_loadu_pd(ax + lane + 8);
+    __m512d lowSumY = _mm512_loadu_pd(ay + lane);
+    __m512d highSumY = _mm512_loadu_pd(ay + lane + 8);
+    for (std::size_t first = 0; first < sourceCount; first += MIXED_RUN) {
+        const std::size_t last = std::min(first + MIXED_RUN, sourceCount);
+        __m512 runX = zero;
+        __m512 runY = zero;
+        for (std::size_t j = first; j < last; ++j) {
+            const __m512 dx = _mm512_add_ps(_mm512_sub_ps(_mm512_set1_ps(s.hiX[j]), hiX),
+                _mm512_sub_ps(_mm512_set1_ps(s.loX[j]), loX));
+            const __m512 dy = _mm512_add_ps(_mm512_sub_ps(_mm512_set1_ps(s.hiY[j]), hiY),
+                _mm512_sub_ps(_mm512_set1_ps(s.loY[j]), loY));
+            const __m512 disSq = _mm512_fmadd_ps(dx, dx, _mm512_mul_ps(dy, dy));
+            // Lanes with coincident bodies are left at zero
+            const __mmask16 live = _mm512_cmp_ps_mask(disSq, zero, _CMP_NEQ_OQ);
+            __m512 inv = _mm512_maskz_rsqrt14_ps(live, disSq);
+            const __m512 half = _mm512_mul_ps(_mm512_set1_ps(0.5f), disSq);
+            inv = _mm512_mul_ps(
+                inv, _mm512_fnmadd_ps(half, _mm512_mul_ps(inv, inv), _mm512_set1_ps(1.5f)));
+            const __m512 scale = _mm512_mul_ps(
+                _mm512_mul_ps(_mm512_set1_ps(pull[j]), inv), _mm512_mul_ps(inv, inv));
+            runX = _mm512_fmadd_ps(scale, dx, runX);
+            runY = _mm512_fmadd_ps(scale, dy, runY);
+        }
+        widenAvx512(runX, lowSumX, highSumX);
+        widenAvx512(runY, lowSumY, highSumY);
+    }
+    _mm512_storeu_pd(ax + lane, lowSumX);
+    _mm512_storeu_pd(ax + lane + 8, highSumX);
+    _mm512_storeu_pd(ay + lane, lowSumY);
+    _mm512_storeu_pd(ay + lane + 8, highSumY);
+}
+
+#endif // SIMD_SOLVER_X86
+
+} // anonymous namespace
+
+SimdSolver::SimdSolver()
+    : level(detect())
+{
+}
+
+[[nodiscard]] SimdLevel SimdSolver::detect() noexcept
+{
+#ifdef SIMD_SOLVER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+void SimdSolver::setLevel(SimdLevel level) noexcept
+{
+    this->level = std::min(level, detect());
+    touch();
+}
+
+[[nodiscard]] SimdLevel SimdSolver::getLevel() const noexcept
+{
+    return level;
+}
+
+void SimdSolver::setPrecision(SimdPrecision precision) noexcept
+{
+    this->precision = precision;
+    touch();
+}
+
+[[nodiscard]] SimdPrecision SimdSolver::getPrecision() const noexcept
+{
+    return precision;
+}
+
+void SimdSolver::accumulate(const BodyStore& bodies, const Axes& acc)
+{
+    double* ax = acc[0];
+    double* ay = acc[1];
+    if (precision == SimdPrecision::Mixed) {
+        accumulateMixed(bodies, ax, ay);
+        return;
+    }
+    const std::size_t count = bodies.size();
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const std::size_t sourceCount = gatherSources(bodies);
+    std::fill_n(ax, count, 0.0);
+    std::fill_n(ay, count, 0.0);
+
+    // Sweep the sources a tile at a time so they stay in cache for every target
+    const double* sx = sourceX.data();
+    const double* sy = sourceY.data();
+    const double* sp = pull.data();
+    auto sweep = [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t first = 0; first < sourceCount; first += TILE) {
+            const std::size_t last = std::min(sourceCount, first + TILE);
+            std::size_t done = begin;
+#ifdef SIMD_SOLVER_X86
+            if (level == SimdLevel::Avx512)
+                done = tileAvx512(x, y, sx, sy, sp, first, last, begin, end, ax, ay);
+            else if (level == SimdLevel::Avx2)
+                done = tileAvx2(x, y, sx, sy, sp, first, last, begin, end, ax, ay);
+#endif
+            tileScalar(x, y, sx, sy, sp, first, last, done, end, ax, ay);
+        }
+    };
+    sweepTargets(count, sweep);
+
+    // The sun in slot 0 pulls on everyone but is not a target
+    if (count > 0) {
+        ax[0] = 0.0;
+        ay[0] = 0.0;
+    }
+}
+
+void SimdSolver::sweepTargets(std::size_t count, const ThreadPool::RangeTask& sweep)
+{
+    if (!isParallel()) {
+        sweep(0, count, 0);
+        return;
+    }
+    // Whole blocks only, so a target meets the same kernel however the range is split
+    getThreadPool()->parallelFor((count + BLOCK - 1) / BLOCK,
+        [&sweep, count](std::size_t begin, std::size_t end, std::size_t worker) {
+            sweep(begin * BLOCK, std::min(count, end * BLOCK), worker);
+        });
+}
+
+[[nodiscard]] std::size_t SimdSolver::gatherSources(const BodyStore& bodies)
+{
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* mass = bodies.mass();
+    // Test particles only feel the others
+    const std::vector<std::uint32_t>& sources = bodies.getSources();
+    const std::size_t sourceCount = sources.size();
+    sourceX.resize(sourceCount);
+    sourceY.resize(sourceCount);
+    pull.resize(sourceCount);
+    for (std::size_t k = 0; k < sourceCount; ++k) {
+        const std::uint32_t j = sources[k];
+        sourceX[k] = x[j];
+        sourceY[k] = y[j];
+        pull[k] = Universe::G * mass[j];
+    }
+    return sourceCount;
+}
+
+void SimdSolver::accumulateMixed(const BodyStore& bodies, double* ax, double* ay)
+{
+    const std::size_t count = bodies.size();
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const std::size_t sourceCount = gatherSources(bodies);
+    const double* sx = sourceX.data();
+    const double* sy = sourceY.data();
+    const double* sp = pull.data();
+
+    // Every group of targets takes its first target as the origin, and every
+    // tile of sources is re-based onto it. Groups start at multiples of
+    // MIXED_GROUP whatever range a worker takes, so the result does not depend
+    // on the threads
+    auto sweep = [&](std::size_t begin, std::size_t end, std::size_t) {
+        MixedTargets targets;
+        MixedSources tile;
+        float scaled[MIXED_TILE];
+        double sumX[MIXED_GROUP];
+        double sumY[MIXED_GROUP];
+        for (std::size_t group = begin / MIXED_GROUP * MIXED_GROUP; group < end;
+             group += MIXED_GROUP) {
+            const std::size_t first = std::max(group, begin) - group;
+            const std::size_t last = std::min(group + MIXED_GROUP, end) - group;
+            // Lanes past the last target fill the final block and are dropped
+            const std::size_t padded = std::min(MIXED_GROUP, (last + BLOCK - 1) / BLOCK * BLOCK);
+            const std::size_t size = std::min(MIXED_GROUP, count - group);
+            const double originX = x[group];
+            const double originY = y[group];
+            double groupExtent = 0.0;
+            for (std::size_t k = 0; k < size; ++k) {
+                groupExtent = std::max({ groupExtent, std::abs(x[group + k] - originX),
+                    std::abs(y[group + k] - originY) });
+            }
+            std::fill(sumX + first, sumX + padded, 0.0);
+            std::fill(sumY + first, sumY + padded, 0.0);
+            for (std::size_t start = 0; start < sourceCount; start += MIXED_TILE) {
+                const std::size_t tileSize = std::min(MIXED_TILE, sourceCount - start);
+                double extent = groupExtent;
+                for (std::size_t k = 0; k < tileSize; ++k) {
+                    extent = std::max({ extent, std::abs(sx[start + k] - originX),
+                        std::abs(sy[start + k] - originY) });
+                }
+                // Scale the offsets into [-1, 1] by a power of two, so the
+                // separations and the pulls stay within the range of a float
+                int exponent = 0;
+                std::frexp(extent, &exponent);
+                const double unit = std::ldexp(1.0, -exponent);
+                for (std::size_t k = first; k < padded; ++k) {
+                    const bool inside = k < last;
+                    splitOffset(inside ? (x[group + k] - originX) * unit : 0.0, targets.hiX[k],
+                        targets.loX[k]);
+                    splitOffset(inside ? (y[group + k] - originY) * unit : 0.0, targets.hiY[k],
+                        targets.loY[k]);
+                }
+                for (std::size_t k = 0; k < tileSize; ++k) {
+                    splitOffset((sx[start + k] - originX) * unit, tile.hiX[k], tile.loX[k]);
+                    splitOffset((sy[start + k] - originY) * unit, tile.hiY[k], tile.loY[k]);
+                    scaled[k] = static_cast<float>(sp[start + k] * unit * unit);
+                }
+                for (std::size_t lane = first; lane < last; lane += BLOCK) {
+#ifdef SIMD_SOLVER_X86
+                    if (level == SimdLevel::Avx512) {
+                        blockAvx512Mixed(targets, lane, tile, scaled, tileSize, sumX, sumY);
+                        continue;
+                    }
+                    if (level == SimdLevel::Avx2) {
+                        blockAvx2Mixed(targets, lane, tile, scaled, tileSize, sumX, sumY);
+                        blockAvx2Mixed(targets, lane + 8, tile, scaled, tileSize, sumX, sumY);
+                        continue;
+                    }
+#endif
+                    blockScalarMixed(targets, lane, std::min(BLOCK, last - lane), tile, scaled,
+                        tileSize, sumX, sumY);
+                }
+            }
+            std::copy(sumX + first, sumX + last, ax + group + first);
+            std::copy(sumY + first, sumY + last, ay + group + first);
+        }
+    };
+    sweepTargets(count, sweep);
+
+    if (count > 0) {
+        ax[0] = 0.0;
+        ay[0] = 0.0;
+    }
+}
@@ -0,0 +1,210 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+thread_local const ThreadPool* currentPool = nullptr; // Pool the calling thread works for
+thread_local std::size_t currentIndex = 0; // Index of the calling thread in currentPool
+
+} // anonymous namespace
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool) noexcept
+    : pool(pool)
+{
+}
+
+ThreadPool::TaskGroup::~TaskGroup()
+{
+    try {
+        wait();
+    } catch (...) {
+        // Already unwinding or nobody asked, the tasks are done either way
+    }
+}
+
+void ThreadPool::TaskGroup::run(Task task)
+{
+    pending.fetch_add(1, std::memory_order_relaxed);
+    pool.push(Job { std::move(task), this });
+}
+
+void ThreadPool::TaskGroup::wait()
+{
+    const std::size_t self = pool.currentWorker();
+    while (pending.load(std::memory_order_acquire) != 0) {
+        // Help with whatever is queued instead of blocking
+        if (!pool.runOne(self))
+            std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    if (failure)
+        std::rethrow_exception(std::exchange(failure, nullptr));
+}
+
+ThreadPool::ThreadPool(std::size_t workers)
+    : workers(workers)
+{
+    if (workers == 0)
+        throw std::logic_error("Thread pool needs at least one worker");
+    slots = std::make_unique<Worker[]>(workers);
+    threads.reserve(workers - 1);
+    for (std::size_t worker = 1; worker < workers; ++worker)
+        threads.emplace_back(&ThreadPool::work, this, worker);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    sleep.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+[[nodiscard]] std::size_t ThreadPool::getWorkerCount() const noexcept
+{
+    return workers;
+}
+
+[[nodiscard]] std::size_t ThreadPool::currentWorker() const noexcept
+{
+    return currentPool == this ? currentIndex : 0;
+}
+
+void ThreadPool::parallelFor(std::size_t count, const RangeTask& task, std::size_t grain)
+{
+    if (workers == 1) {
+        task(0, count, 0);
+        return;
+    }
+    if (grain == 0)
+        grain = count / (workers * 4);
+    grain = std::max(grain, CHUNK_ALIGN);
+
+    // Keep the left half, leave the right half for thieves, repeat. The root is
+    // queued like any other task so the counters cover the whole range.
+    TaskGroup group(*this);
+    std::function<void(std::size_t, std::size_t)> split
+        = [&](std::size_t begin, std::size_t end) {
+              while (end - begin > grain) {
+                  const std::size_t mid
+                      = begin + ((end - begin) / 2 + CHUNK_ALIGN - 1) / CHUNK_ALIGN * CHUNK_ALIGN;
+                  if (mid >= end)
+                      break;
+                  group.run([&split, mid, end] { split(mid, end); });
+                  end = mid;
+              }
+              task(begin, end, currentWorker());
+          };
+    group.run([&split, count] { split(0, count); });
+    group.wait();
+}
+
+[[nodiscard]] std::vector<ThreadPool::WorkerStats> ThreadPool::getStats() const
+{
+    std::vector<WorkerStats> stats(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        stats[i].tasks = slots[i].tasks.load(std::memory_order_relaxed);
+        stats[i].steals = slots[i].steals.load(std::memory_order_relaxed);
+        stats[i].busySeconds
+            = static_cast<double>(slots[i].busyNanos.load(std::memory_order_relaxed)) * 1e-9;
+    }
+    return stats;
+}
+
+void ThreadPool::resetStats() noexcept
+{
+    for (std::size_t i = 0; i < workers; ++i) {
+        slots[i].tasks.store(0, std::memory_order_relaxed);
+        slots[i].steals.store(0, std::memory_order_relaxed);
+        slots[i].busyNanos.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ThreadPool::push(Job job)
+{
+    Worker& own = slots[currentWorker()];
+    {
+        std::lock_guard<std::mutex> guard(own.lock);
+        own.jobs.push_back(std::move(job));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    // Taking the lock orders this against a worker checking queued before it sleeps
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+    }
+    sleep.notify_one();
+}
+
+bool ThreadPool::runOne(std::size_t self)
+{
+    std::optional<Job> job;
+    bool stolen = false;
+    {
+        Worker& own = slots[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.jobs.empty()) {
+            job.emplace(std::move(own.jobs.back()));
+            own.jobs.pop_back();
+        }
+    }
+    for (std::size_t step = 1; !job && step < workers; ++step) {
+        Worker& victim = slots[(self + step) % workers];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.jobs.empty()) {
+            job.emplace(std::move(victim.jobs.front()));
+            victim.jobs.pop_front();
+            stolen = true;
+        }
+    }
+    if (!job)
+        return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+
+    const auto start = std::chrono::steady_clock::now();
+    TaskGroup& group = *job->group;
+    try {
+        job->task();
+    } catch (...) {
+        std::lock_guard<std::mutex> guard(group.lock);
+        if (!group.failure)
+            group.failure = std::current_exception();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    Worker& own = slots[self];
+    own.tasks.fetch_add(1, std::memory_order_relaxed);
+    if (stolen)
+        own.steals.fetch_add(1, std::memory_order_relaxed);
+    own.busyNanos.fetch_add(
+        static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+        std::memory_order_relaxed);
+    // Last, the group may be destroyed as soon as its waiter sees zero
+    group.pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void ThreadPool::work(std::size_t self)
+{
+    currentPool = this;
+    currentIndex = self;
+    while (true) {
+        if (runOne(self))
+            continue;
+        std::unique_lock<std::mutex> guard(sleepLock);
+        sleep.wait(guard,
+            [this] { return stopping || queued.load(std::memory_order_acquire) != 0; });
+        if (stopping)
+            return;
+    }
+}
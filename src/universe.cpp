@@ -3,8 +3,15 @@
 // Iterator typedefs
 #include "universe.h"
 #include "./vector.h"
+#include "integrators/euler.h"
 #include "objects/object.h"
+#include "solvers/direct_solver.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 class Object;
 class ObjectFactory;
@@ -14,6 +21,13 @@ typedef std::vector<Object*>::const_iterator const_iterator;
 
 Universe* Universe::inst = nullptr;
 
+namespace {
+
+constexpr std::size_t VISIT_GRAIN = 64; // Objects per task of a parallel traversal
+constexpr double REST_SLIVER = 1e-9; // Fraction of a step below which advanceUntil stops early
+
+} // anonymous namespace
+
 Universe* Universe::instance()
 {
     if (!inst) {
@@ -22,10 +36,19 @@ Universe* Universe::instance()
     return inst;
 }
 
+Universe::Universe()
+    : solver(std::make_unique<DirectSolver>())
+    , integrator(std::make_unique<EulerIntegrator>())
+{
+}
+
 Universe::~Universe()
 {
     release(objects);
-    inst = nullptr;
+    release(merged);
+    // Independent Universes leave the process wide one alone
+    if (inst == this)
+        inst = nullptr;
 }
 
 Universe::iterator Universe::begin()
@@ -61,41 +84,471 @@ Universe::iterator Universe::begin()
     return snapshot;
 }
 
+[[nodiscard]] const BodyStore& Universe::snapshot()
+{
+    // Copy assignment reuses the capacity of the buffer
+    BodyStore& target = frozen[nextFrozen];
+    target = bodies;
+    frozenTime[nextFrozen] = time;
+    nextFrozen = 1 - nextFrozen;
+    return target;
+}
+
+void Universe::restore(const BodyStore& state)
+{
+    std::size_t buffer = 0;
+    while (buffer < frozen.size() && &frozen[buffer] != &state)
+        ++buffer;
+    if (buffer == frozen.size())
+        throw std::logic_error("State was not frozen by snapshot()");
+    if (state.size() != bodies.size())
+        throw std::logic_error("Snapshot does not match the registered objects");
+    bodies = state;
+    time = frozenTime[buffer];
+    // The store moved back in time, so state derived from it is stale
+    bodies.touch();
+}
+
+[[nodiscard]] const BodyStore& Universe::getBodies() const noexcept
+{
+    return bodies;
+}
+
+void Universe::setForceSolver(std::unique_ptr<ForceSolver> solver)
+{
+    if (!solver)
+        throw std::logic_error("Force solver must not be null");
+    this->solver = std::move(solver);
+    this->solver->setThreadPool(pool.get());
+    this->solver->setDeterministic(deterministic);
+}
+
+[[nodiscard]] ForceSolver& Universe::getForceSolver() noexcept
+{
+    return *solver;
+}
+
+void Universe::setIntegrator(std::unique_ptr<Integrator> integrator)
+{
+    if (!integrator)
+        throw std::logic_error("Integrator must not be null");
+    this->integrator = std::move(integrator);
+    this->integrator->setThreadPool(pool.get());
+}
+
+[[nodiscard]] Integrator& Universe::getIntegrator() noexcept
+{
+    return *integrator;
+}
+
+void Universe::setThreadCount(std::size_t threads)
+{
+    if (threads == 0)
+        throw std::logic_error("Thread count must be positive");
+    solver->setThreadPool(nullptr);
+    integrator->setThreadPool(nullptr);
+    pool.reset();
+    if (threads > 1)
+        pool = std::make_unique<ThreadPool>(threads);
+    solver->setThreadPool(pool.get());
+    integrator->setThreadPool(pool.get());
+}
+
+[[nodiscard]] std::size_t Universe::getThreadCount() const noexcept
+{
+    return pool ? pool->getWorkerCount() : 1;
+}
+
+[[nodiscard]] ThreadPool* Universe::getThreadPool() noexcept
+{
+    return pool.get();
+}
+
+void Universe::setDeterministic(bool enabled) noexcept
+{
+    deterministic = enabled;
+    solver->setDeterministic(enabled);
+}
+
+[[nodiscard]] bool Universe::getDeterministic() const noexcept
+{
+    return deterministic;
+}
+
+void Universe::setParticleThreshold(double mass)
+{
+    if (!(mass >= 0.0))
+        throw std::logic_error("Particle threshold must not be negative");
+    particleThreshold = mass;
+    // The sun in slot 0 always pulls
+    bodies.setParticlesBelow(mass, 1);
+}
+
+[[nodiscard]] double Universe::getParticleThreshold() const noexcept
+{
+    return particleThreshold;
+}
+
+void Universe::setKeplerRatio(double ratio)
+{
+    if (!(ratio >= 0.0))
+        throw std::logic_error("Kepler ratio must not be negative");
+    keplerRatio = ratio;
+    // Reclassify on the next step
+    splitVersion = 0;
+    if (ratio == 0.0) {
+        kepler.reset(0.0, Vector2(), time);
+        onKepler.clear();
+    }
+}
+
+[[nodiscard]] double Universe::getKeplerRatio() const noexcept
+{
+    return keplerRatio;
+}
+
+[[nodiscard]] bool Universe::isOnKepler(std::size_t slot) const noexcept
+{
+    return slot < onKepler.size() && onKepler[slot] != 0;
+}
+
+[[nodiscard]] std::size_t Universe::getKeplerCount() const noexcept
+{
+    return kepler.size();
+}
+
+void Universe::setCollisionMode(CollisionMode mode) noexcept
+{
+    collisionMode = mode;
+}
+
+[[nodiscard]] Universe::CollisionMode Universe::getCollisionMode() const noexcept
+{
+    return collisionMode;
+}
+
+void Universe::setEncounterDistance(double distance)
+{
+    detector.setEncounterDistance(distance);
+}
+
+[[nodiscard]] double Universe::getEncounterDistance() const noexcept
+{
+    return detector.getEncounterDistance();
+}
+
+[[nodiscard]] const std::vector<CollisionEvent>& Universe::getCollisionEvents() const noexcept
+{
+    return collisionEvents;
+}
+
+void Universe::clearCollisionEvents() noexcept
+{
+    collisionEvents.clear();
+}
+
+void Universe::accept(Visitor& visitor, bool parallel)
+{
+    if (!parallel || !pool) {
+        for (auto* obj : objects)
+            obj->accept(visitor);
+        return;
+    }
+    pool->parallelFor(
+        objects.size(),
+        [this, &visitor](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i)
+                objects[i]->accept(visitor);
+        },
+        VISIT_GRAIN);
+}
+
 void Universe::stepSimulation(const double& timeSec)
 {
-    for (auto iter = ++this->begin(); iter != this->end(); ++iter) {
+    if (keplerRatio > 0.0 && bodies.size() > 1)
+        stepSplit(timeSec);
+    else
+        integrator->step(bodies, *solver, timeSec);
+    time += timeSec;
+    if (collisionMode != CollisionMode::Off)
+        collide();
+}
+
+void Universe::stepSplit(double timeSec)
+{
+    if (bodies.getVersion() != splitVersion || stepsSinceSplit >= KEPLER_RECHECK)
+        split();
+    ++stepsSinceSplit;
+    integrator->step(integrated, *solver, timeSec);
+
+    // Copy the integrated bodies back, then overwrite the ones on orbits
+    const std::size_t count = integratedSlots.size();
+    for (std::size_t k = 1; k < count; ++k) {
+        const std::uint32_t slot = integratedSlots[k];
+        bodies.x()[slot] = integrated.x()[k];
+        bodies.y()[slot] = integrated.y()[k];
+        bodies.vx()[slot] = integrated.vx()[k];
+        bodies.vy()[slot] = integrated.vy()[k];
+    }
+    kepler.propagate(time + timeSec, bodies, pool.get());
+    bodies.touch();
+    splitVersion = bodies.getVersion();
+
+    // Bodies that pull were only integrated along for the others
+    if (keplerSources.empty())
+        return;
+    for (const std::uint32_t k : keplerSources) {
+        const std::uint32_t slot = integratedSlots[k];
+        integrated.x()[k] = bodies.x()[slot];
+        integrated.y()[k] = bodies.y()[slot];
+        integrated.vx()[k] = bodies.vx()[slot];
+        integrated.vy()[k] = bodies.vy()[slot];
+    }
+    integrated.touch();
+}
+
+void Universe::split()
+{
+    stepsSinceSplit = 0;
+    const std::size_t count = bodies.size();
+    splitX.resize(count);
+    splitY.resize(count);
+    solver->computeAccelerations(bodies, splitX.data(), splitY.data());
+
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double mu = G * bodies.getMass(0);
+    kepler.reset(mu, bodies.getPosition(0), time);
+    onKepler.assign(count, 0);
+    integrated.clear();
+    integratedSlots.clear();
+    keplerSources.clear();
+    integrated.add(bodies.getMass(0), bodies.getPosition(0), bodies.getVelocity(0));
+    integratedSlots.push_back(0);
+    for (std::size_t slot = 1; slot < count; ++slot) {
+        // Pull of everything but the sun over the pull of the sun
+        const double dx = x[0] - x[slot];
+        const double dy = y[0] - y[slot];
+        const double disSq = dx * dx + dy * dy;
+        if (disSq > 0.0) {
+            const double scale = mu / (disSq * std::sqrt(disSq));
+            const double sunX = scale * dx;
+            const double sunY = scale * dy;
+            const double ratio = std::hypot(splitX[slot] - sunX, splitY[slot] - sunY)
+                / std::hypot(sunX, sunY);
+            onKepler[slot] = ratio < keplerRatio ? 1 : 0;
+        }
+
+        const bool particle = bodies.isParticle(slot);
+        if (onKepler[slot]) {
+            kepler.add(slot, bodies.getPosition(slot), bodies.getVelocity(slot));
+            if (particle)
+                continue;
+            keplerSources.push_back(static_cast<std::uint32_t>(integrated.size()));
+        }
+        integratedSlots.push_back(static_cast<std::uint32_t>(slot));
+        integrated.add(
+            bodies.getMass(slot), bodies.getPosition(slot), bodies.getVelocity(slot), particle);
+    }
+    splitVersion = bodies.getVersion();
+}
+
+void Universe::collide()
+{
+    const std::vector<Encounter>& found = detector.detect(bodies);
+    if (found.empty())
+        return;
+
+    const bool merging = collisionMode == CollisionMode::Merge;
+    if (merging)
+        absorbed.assign(bodies.size(), 0);
+    std::size_t firstGone = bodies.size();
+    for (const Encounter& encounter : found) {
+        CollisionEvent event { time, objects[encounter.first]->getName(),
+            objects[encounter.second]->getName(), encounter.distance, encounter.impact, false };
+        // A body absorbed earlier in this step collides again next step, if at all
+        if (merging && encounter.impact && !absorbed[encounter.first]
+            && !absorbed[encounter.second]) {
+            const double* mass = bodies.mass();
+            // The sun in slot 0 always survives
+            const bool keepFirst
+                = encounter.first == 0 || mass[encounter.first] >= mass[encounter.second];
+            const std::uint32_t keep = keepFirst ? encounter.first : encounter.second;
+            const std::uint32_t gone = keepFirst ? encounter.second : encounter.first;
+            merge(keep, gone);
+            absorbed[gone] = 1;
+            firstGone = std::min<std::size_t>(firstGone, gone);
+            event.merged = true;
+        }
+        collisionEvents.push_back(std::move(event));
+    }
+    if (firstGone == bodies.size())
+        return;
+
+    // Remove from the back so the slots still to visit stay put
+    for (std::size_t slot = bodies.size(); slot-- > firstGone;) {
+        if (!absorbed[slot])
+            continue;
+        objects[slot]->unbind();
+        merged.push_back(objects[slot]);
+        objects.erase(objects.begin() + static_cast<std::ptrdiff_t>(slot));
+        bodies.remove(slot);
+    }
+    for (std::size_t slot = firstGone; slot < objects.size(); ++slot)
+        objects[slot]->bind(&bodies, slot);
+}
 
-        Vector2 vel = (*iter)->getVelocity();
-        Vector2 newPos = (*iter)->getPosition() + timeSec * vel;
-        Vector2 acc = ((*this).sumForce(*iter)) / (*iter)->getMass();
-        Vector2 newVel = (*iter)->getVelocity() + timeSec * acc;
+void Universe::merge(std::size_t keep, std::size_t gone)
+{
+    const double keepMass = bodies.getMass(keep);
+    const double goneMass = bodies.getMass(gone);
+    const double total = keepMass + goneMass;
+    if (keep != 0 && total > 0.0) {
+        // Center of mass and total momentum
+        bodies.setPosition(keep,
+            (keepMass * bodies.getPosition(keep) + goneMass * bodies.getPosition(gone)) / total);
+        bodies.setVelocity(keep,
+            (keepMass * bodies.getVelocity(keep) + goneMass * bodies.getVelocity(gone)) / total);
+    }
+    const double keepRadius = bodies.getRadius(keep);
+    const double goneRadius = bodies.getRadius(gone);
+    bodies.setRadius(keep,
+        std::cbrt(keepRadius * keepRadius * keepRadius + goneRadius * goneRadius * goneRadius));
+    bodies.setMass(keep, total);
+    // A particle that swallows a massive body pulls from now on
+    if (keep != 0 && !bodies.isParticle(gone))
+        bodies.setParticle(keep, false);
+}
 
-        (*iter)->setPosition(newPos);
-        (*iter)->setVelocity(newVel);
+void Universe::advance(double dt, std::size_t steps, const Sampler& sampler, std::size_t every)
+{
+    if (every == 0)
+        throw std::logic_error("Sampling interval must be positive");
+    const double start = time;
+    std::size_t done = 0;
+    while (done < steps) {
+        const std::size_t batch = sampler ? std::min(every, steps - done) : steps - done;
+        if ((keplerRatio > 0.0 && bodies.size() > 1) || collisionMode != CollisionMode::Off) {
+            // Bodies may switch to Kepler orbits or merge at any step
+            for (std::size_t n = 0; n < batch; ++n)
+                stepSimulation(dt);
+        } else {
+            integrator->advance(bodies, *solver, dt, batch);
+        }
+        done += batch;
+        time = start + static_cast<double>(done) * dt;
+        if (sampler && done % every == 0)
+            sampler(time, bodies);
     }
 }
 
+void Universe::advanceUntil(double target, double dt, const Sampler& sampler, std::size_t every)
+{
+    const double span = target - time;
+    if (dt == 0.0 || !std::isfinite(dt) || span / dt < 0.0)
+        throw std::logic_error("Time step must point from the current time to the target");
+    if (every == 0)
+        throw std::logic_error("Sampling interval must be positive");
+
+    const double whole = std::floor(span / dt);
+    const auto steps = static_cast<std::size_t>(whole);
+    advance(dt, steps, sampler, every);
+    // Shorten the last step to land on target, ignoring rounding slivers
+    const double rest = span - whole * dt;
+    if (std::abs(rest) > REST_SLIVER * std::abs(dt)) {
+        stepSimulation(rest);
+        if (sampler && (steps + 1) % every == 0)
+            sampler(target, bodies);
+    }
+    time = target;
+}
+
+[[nodiscard]] double Universe::getTime() const noexcept
+{
+    return time;
+}
+
+void Universe::advanceTo(double target, const std::vector<double>& samples,
+    const DormandPrinceIntegrator::DenseOutput& output)
+{
+    auto* adaptive = dynamic_cast<DormandPrinceIntegrator*>(integrator.get());
+    if (!adaptive)
+        throw std::logic_error("advanceTo needs a DormandPrinceIntegrator");
+
+    // The integrator works with offsets from the current time
+    const double start = time;
+    std::vector<double> offsets(samples.size());
+    for (std::size_t k = 0; k < samples.size(); ++k)
+        offsets[k] = samples[k] - start;
+    adaptive->advanceDense(bodies, *solver, target - start, offsets,
+        [&output, start](double offset, const BodyStore& state) { output(start + offset, state); });
+    time = target;
+}
+
 void Universe::swap(std::vector<Object*>& snapshot)
 {
+    // Read the new state before touching the store, the snapshot may hold handles onto it
+    BodyStore next;
+    next.reserve(snapshot.size());
+    for (const auto* obj : snapshot) {
+        // The sun in slot 0 always pulls, whatever the snapshot says
+        const bool particle = next.size() > 0 && obj->isTestParticle();
+        const std::size_t slot
+            = next.add(obj->getMass(), obj->getPosition(), obj->getVelocity(), particle);
+        next.setRadius(slot, obj->getRadius());
+    }
+
     auto temp = objects;
     objects = snapshot;
+    bodies = std::move(next);
+    for (std::size_t slot = 0; slot < objects.size(); ++slot) {
+        objects[slot]->bind(&bodies, slot);
+    }
     release(temp);
 }
 
 Object* Universe::addObject(Object* ptr)
 {
+    const bool particle = bodies.size() > 0
+        && (ptr->isTestParticle() || ptr->getMass() < particleThreshold);
+    const std::size_t slot
+        = bodies.add(ptr->getMass(), ptr->getPosition(), ptr->getVelocity(), particle);
+    bodies.setRadius(slot, ptr->getRadius());
     objects.push_back(ptr);
+    ptr->bind(&bodies, slot);
     return ptr;
 }
 
 [[nodiscard]] Vector2 Universe::sumForce(const Object* obj) const
 {
+    const Vector2 pos = obj->getPosition();
+    const double mass = obj->getMass();
+    const double* x = bodies.x();
+    const double* y = bodies.y();
+    const double* masses = bodies.activeMass();
+
+    // Test particles pull on nobody
+    const bool compensated = integrator->getCompensation();
     Vector2 sum;
-    for (auto& object : objects) {
-        if (object != obj)
-            sum += obj->getForce(*object);
+    Vector2 carry;
+    for (const std::uint32_t j : bodies.getSources()) {
+        if (objects[j] == obj)
+            continue;
+        const double dx = x[j] - pos[0];
+        const double dy = y[j] - pos[1];
+        const double disSq = dx * dx + dy * dy;
+        if (disSq == 0.0)
+            continue;
+        const double scale = G * mass * masses[j] / (disSq * std::sqrt(disSq));
+        if (compensated) {
+            Integrator::compensatedAdd(sum[0], carry[0], scale * dx);
+            Integrator::compensatedAdd(sum[1], carry[1], scale * dy);
+        } else {
+            sum[0] += scale * dx;
+            sum[1] += scale * dy;
+        }
     }
-    return sum;
+    return sum + carry;
 }
 
 void Universe::release(std::vector<Object*>& objects)
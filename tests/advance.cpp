@@ -0,0 +1,130 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "body_store.h"
+#include "integrators/euler.h"
+#include "integrators/leapfrog.h"
+#include "integrators/yoshida.h"
+#include "parser.h"
+#include "universe.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing the batched advance of the Universe.
+class AdvanceTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Runs solar_system.json for 1000 hourly steps and returns the final positions
+ * @param integrator - scheme to step with
+ * @param batched - true to use advance(), false to call stepSimulation() in a loop
+ */
+std::vector<Vector2> runPlanets(std::unique_ptr<Integrator> integrator, bool batched)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    univ->setIntegrator(std::move(integrator));
+    if (batched) {
+        univ->advance(3600, 1000);
+    } else {
+        for (int i = 0; i < 1000; ++i)
+            univ->stepSimulation(3600);
+    }
+    EXPECT_DOUBLE_EQ(univ->getTime(), 3600.0 * 1000);
+
+    std::vector<Vector2> positions;
+    for (std::size_t slot = 0; slot < univ->getBodies().size(); ++slot)
+        positions.push_back(univ->getBodies().getPosition(slot));
+    return positions;
+}
+
+} // anonymous namespace
+
+TEST_F(AdvanceTest, MatchesSteppedLoop)
+{
+    // The Euler batch does the same arithmetic
+    const std::vector<Vector2> euler = runPlanets(std::make_unique<EulerIntegrator>(), false);
+    EXPECT_EQ(runPlanets(std::make_unique<EulerIntegrator>(), true), euler);
+
+    // Merged kicks only round differently, millimeters over a billion kilometers
+    const std::vector<Vector2> leapfrog = runPlanets(std::make_unique<LeapfrogIntegrator>(), false);
+    const std::vector<Vector2> fused = runPlanets(std::make_unique<LeapfrogIntegrator>(), true);
+    const std::vector<Vector2> yoshida = runPlanets(std::make_unique<YoshidaIntegrator>(6), false);
+    const std::vector<Vector2> composed = runPlanets(std::make_unique<YoshidaIntegrator>(6), true);
+    for (std::size_t slot = 0; slot < leapfrog.size(); ++slot) {
+        assertVector(fused[slot], leapfrog[slot], 1e-2);
+        assertVector(composed[slot], yoshida[slot], 1e-2);
+    }
+}
+
+TEST_F(AdvanceTest, OneEvaluationPerSubStep)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    univ->setIntegrator(std::make_unique<YoshidaIntegrator>(4));
+    univ->advance(3600, 100);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 1U + 3 * 100);
+
+    // The last evaluation of the batch opens the next step
+    univ->stepSimulation(3600);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 1U + 3 * 101);
+}
+
+TEST_F(AdvanceTest, SamplesEveryKSteps)
+{
+    std::vector<Vector2> stepped;
+    {
+        const std::unique_ptr<Universe> univ(Universe::instance());
+        Parser::loadFile("../tests/earth_year.json");
+        for (int i = 1; i <= 1050; ++i) {
+            univ->stepSimulation(60);
+            if (i % 100 == 0)
+                stepped.push_back(univ->getBodies().getPosition(1));
+        }
+    }
+
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/earth_year.json");
+    std::vector<double> times;
+    std::vector<Vector2> sampled;
+    univ->advance(
+        60, 1050,
+        [&](double time, const BodyStore& state) {
+            times.push_back(time);
+            sampled.push_back(state.getPosition(1));
+        },
+        100);
+    ASSERT_EQ(times.size(), 10U);
+    EXPECT_DOUBLE_EQ(times.front(), 6000.0);
+    EXPECT_DOUBLE_EQ(times.back(), 60000.0);
+    EXPECT_EQ(sampled, stepped);
+    EXPECT_DOUBLE_EQ(univ->getTime(), 63000.0);
+    EXPECT_THROW(univ->advance(60, 10, {}, 0), std::logic_error);
+}
+
+TEST_F(AdvanceTest, AdvanceUntilLandsOnTarget)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/earth_year.json");
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    const Vector2 start = univ->getBodies().getPosition(1);
+
+    // 27 whole steps and a shortened 28th, which counts for the sampling
+    std::vector<double> times;
+    univ->advanceUntil(1e5, 3600, [&](double time, const BodyStore&) { times.push_back(time); }, 7);
+    EXPECT_EQ(univ->getTime(), 1e5);
+    EXPECT_EQ(times, (std::vector<double> { 7 * 3600.0, 14 * 3600.0, 21 * 3600.0, 1e5 }));
+
+    // And back again
+    univ->advanceUntil(0.0, -3600);
+    EXPECT_EQ(univ->getTime(), 0.0);
+    assertVector(univ->getBodies().getPosition(1), start, 1.0);
+
+    univ->advanceUntil(0.0, 3600);
+    EXPECT_EQ(univ->getTime(), 0.0);
+    EXPECT_THROW(univ->advanceUntil(1e5, -3600), std::logic_error);
+    EXPECT_THROW(univ->advanceUntil(1e5, 0.0), std::logic_error);
+}
@@ -0,0 +1,86 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "objects/object_factory.h"
+#include "solvers/barnes_hut.h"
+#include "solvers/direct_solver.h"
+#include "universe.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+// The fixture for testing the Barnes-Hut force solver.
+class BarnesHutTest : public ::testing::Test { };
+
+TEST_F(BarnesHutTest, ZeroThetaMatchesDirectSum)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(500);
+
+    BarnesHutSolver solver(0.0);
+    const ForceError error = solver.validate(univ->getBodies());
+    EXPECT_LT(error.maxRelative, 1e-12);
+}
+
+TEST_F(BarnesHutTest, ErrorShrinksWithTheta)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(2000);
+
+    BarnesHutSolver coarse(1.0);
+    BarnesHutSolver fine(0.3);
+    const ForceError coarseError = coarse.validate(univ->getBodies());
+    const ForceError fineError = fine.validate(univ->getBodies());
+    EXPECT_LT(fineError.rmsRelative, coarseError.rmsRelative);
+    EXPECT_LT(fineError.maxRelative, 1e-4);
+    EXPECT_LT(coarseError.maxRelative, 1e-2);
+    EXPECT_GT(fine.getNodeCount(), 1u);
+}
+
+TEST_F(BarnesHutTest, SelectableOnUniverseWithValidation)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeEarth();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(300);
+
+    auto solver = std::make_unique<BarnesHutSolver>(0.5);
+    solver->setValidation(true);
+    univ->setForceSolver(std::move(solver));
+    for (int i = 0; i < 5; ++i)
+        univ->stepSimulation(3600);
+
+    const ForceSolver& active = univ->getForceSolver();
+    EXPECT_TRUE(active.getValidation());
+    EXPECT_GT(active.getLastError().maxRelative, 0.0);
+    EXPECT_LT(active.getLastError().maxRelative, 1e-3);
+    EXPECT_LE(active.getLastError().rmsRelative, active.getLastError().maxRelative);
+}
+
+TEST_F(BarnesHutTest, WideAngleNeverFoldsTargetIntoItself)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    // Heavy bodies on a ring, so a target inside an accepted cell would feel
+    // a good part of its own mass
+    for (int i = 0; i < 12; ++i) {
+        const double phi = 2.0 * M_PI * i / 12.0;
+        ObjectFactory::makePlanet("ring-" + std::to_string(i), 1e30,
+            makeVector2(1e11 * std::cos(phi), 1e11 * std::sin(phi)), makeVector2(0, 0));
+    }
+
+    BarnesHutSolver solver(4.0);
+    const ForceError error = solver.validate(univ->getBodies());
+    EXPECT_LT(error.maxRelative, 0.5);
+}
+
+TEST_F(BarnesHutTest, RejectsInvalidConfiguration)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    EXPECT_THROW(BarnesHutSolver(-0.1), std::logic_error);
+    EXPECT_THROW(univ->setForceSolver(nullptr), std::logic_error);
+}
@@ -0,0 +1,116 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "body_store.h"
+#include "objects/object.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "universe.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+
+// The fixture for testing the structure-of-arrays body store behind the Universe.
+class BodyStoreTest : public ::testing::Test { };
+
+TEST_F(BodyStoreTest, ObjectsAreHandlesOntoStore)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    Object* earth = ObjectFactory::makeEarth();
+
+    const BodyStore& bodies = univ->getBodies();
+    ASSERT_EQ(bodies.size(), 2u);
+    EXPECT_EQ(bodies.getMass(1), 5.9742e24);
+    assertVector(bodies.getPosition(1), makeVector2(149597870700, 0));
+
+    // Writes through the handle land in the store and vice versa
+    earth->setPosition(makeVector2(1, 2));
+    earth->setVelocity(makeVector2(3, 4));
+    assertVector(bodies.getPosition(1), makeVector2(1, 2));
+    assertVector(bodies.getVelocity(1), makeVector2(3, 4));
+    EXPECT_EQ(bodies.x()[1], 1);
+    EXPECT_EQ(bodies.vy()[1], 4);
+}
+
+TEST_F(BodyStoreTest, StepUpdatesStoreAndKeepsSunFixed)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    const Object* sun = ObjectFactory::makeSun();
+    const Object* earth = ObjectFactory::makeEarth();
+    const Vector2 start = earth->getPosition();
+
+    univ->stepSimulation(3600);
+
+    assertVector(sun->getPosition(), makeVector2(0, 0));
+    assertVector(sun->getVelocity(), makeVector2(0, 0));
+    // Position moves with the old velocity, velocity with the force at the old position
+    assertVector(earth->getPosition(), start + 3600 * makeVector2(0, 29788.4676), 1e-3);
+    const double acc = Universe::G * sun->getMass() / (start[0] * start[0]);
+    EXPECT_NEAR(earth->getVelocity()[0], -3600 * acc, 1e-9);
+    EXPECT_NEAR(earth->getVelocity()[1], 29788.4676, 1e-9);
+}
+
+TEST_F(BodyStoreTest, SwapRebuildsStoreFromSnapshot)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeMercury();
+    ObjectFactory::makeVenus();
+
+    // Clones are detached from the store, stepping leaves them untouched
+    std::vector<Object*> snapshot = univ->getSnapshot();
+    const Vector2 frozen = snapshot[1]->getPosition();
+    univ->stepSimulation(3600);
+    assertVector(snapshot[1]->getPosition(), frozen);
+
+    univ->swap(snapshot);
+    const Object& mercury = **(++univ->begin());
+    assertVector(mercury.getPosition(), frozen);
+    assertVector(univ->getBodies().getPosition(1), frozen);
+
+    // The swapped in objects are now handles and follow the simulation
+    univ->stepSimulation(3600);
+    EXPECT_NE(mercury.getPosition(), frozen);
+    assertVector(univ->getBodies().getPosition(1), mercury.getPosition());
+}
+
+TEST_F(BodyStoreTest, VersionTracksState)
+{
+    BodyStore first;
+    BodyStore second;
+    EXPECT_NE(first.getVersion(), second.getVersion());
+
+    std::uint64_t version = first.getVersion();
+    first.add(1e24, makeVector2(1, 2), makeVector2(3, 4));
+    EXPECT_NE(first.getVersion(), version);
+
+    version = first.getVersion();
+    first.setVelocity(0, makeVector2(5, 6));
+    EXPECT_NE(first.getVersion(), version);
+    version = first.getVersion();
+    first.setPosition(0, makeVector2(7, 8));
+    EXPECT_NE(first.getVersion(), version);
+
+    // Raw writes go unnoticed until touched
+    version = first.getVersion();
+    first.vx()[0] = 1;
+    EXPECT_EQ(first.getVersion(), version);
+
+    version = first.getVersion();
+    first.x()[0] = 9;
+    first.touch();
+    EXPECT_NE(first.getVersion(), version);
+
+    // Copies are told apart from the original, a move hands its version over
+    BodyStore copy(first);
+    EXPECT_NE(copy.getVersion(), first.getVersion());
+    second = first;
+    EXPECT_NE(second.getVersion(), first.getVersion());
+    EXPECT_NE(second.getVersion(), copy.getVersion());
+    version = copy.getVersion();
+    const BodyStore moved(std::move(copy));
+    EXPECT_EQ(moved.getVersion(), version);
+    EXPECT_NE(copy.getVersion(), version);
+}
@@ -0,0 +1,174 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "body_store.h"
+#include "collision_detector.h"
+#include "integrators/leapfrog.h"
+#include "objects/object.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "universe.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// The fixture for testing the collision detection and merging.
+class CollisionsTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Returns the pairs closer than the sum of their radii plus gap, by checking all of them
+ * @param bodies - state to examine
+ * @param gap - encounter distance
+ */
+std::vector<std::pair<std::uint32_t, std::uint32_t>> bruteForce(
+    const BodyStore& bodies, double gap)
+{
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+    for (std::uint32_t i = 0; i < bodies.size(); ++i) {
+        for (std::uint32_t j = i + 1; j < bodies.size(); ++j) {
+            const double reach = bodies.getRadius(i) + bodies.getRadius(j) + gap;
+            if ((bodies.getPosition(j) - bodies.getPosition(i)).normSq() <= reach * reach)
+                pairs.emplace_back(i, j);
+        }
+    }
+    return pairs;
+}
+
+/**
+ * Returns the slots of the pairs found by the detector
+ */
+std::vector<std::pair<std::uint32_t, std::uint32_t>> slotsOf(
+    const std::vector<Encounter>& encounters)
+{
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+    for (const Encounter& encounter : encounters)
+        pairs.emplace_back(encounter.first, encounter.second);
+    return pairs;
+}
+
+} // anonymous namespace
+
+TEST_F(CollisionsTest, SweepFindsEveryPair)
+{
+    // A crowded box of bodies with radii spanning five orders of magnitude
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coordinate(0.0, 1e9);
+    std::uniform_real_distribution<double> logRadius(2.0, 7.0);
+    std::uniform_real_distribution<double> drift(-3e6, 3e6);
+    BodyStore bodies;
+    bodies.add(2e30, makeVector2(5e8, 5e8), makeVector2());
+    bodies.setRadius(0, 7e7);
+    for (int i = 0; i < 3000; ++i) {
+        const std::size_t slot = bodies.add(
+            1e15, makeVector2(coordinate(rng), coordinate(rng)), makeVector2(), i % 3 == 0);
+        bodies.setRadius(slot, std::pow(10.0, logRadius(rng)));
+    }
+
+    CollisionDetector detector;
+    detector.setEncounterDistance(1e6);
+    EXPECT_EQ(slotsOf(detector.detect(bodies)), bruteForce(bodies, 1e6));
+    EXPECT_LT(detector.getCandidateCount(), bodies.size() * 20);
+
+    // Nudged bodies are re-sorted by insertion
+    for (std::size_t slot = 1; slot < bodies.size(); ++slot) {
+        bodies.x()[slot] += drift(rng);
+        bodies.y()[slot] += drift(rng);
+    }
+    const std::vector<Encounter>& found = detector.detect(bodies);
+    EXPECT_EQ(slotsOf(found), bruteForce(bodies, 1e6));
+    for (const Encounter& encounter : found) {
+        const double touch = bodies.getRadius(encounter.first) + bodies.getRadius(encounter.second);
+        EXPECT_EQ(encounter.impact, encounter.distance <= touch);
+    }
+
+    // Scrambled bodies fall back to a full sort
+    std::shuffle(bodies.x(), bodies.x() + bodies.size(), rng);
+    EXPECT_EQ(slotsOf(detector.detect(bodies)), bruteForce(bodies, 1e6));
+    EXPECT_THROW(detector.setEncounterDistance(-1.0), std::logic_error);
+}
+
+TEST_F(CollisionsTest, MergeConservesMassAndMomentum)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    // Far enough out that the sun's pull does not matter over a second
+    Planet* heavy = ObjectFactory::makePlanet(
+        "heavy", 6e24, makeVector2(1e15, 0), makeVector2(0, 3e4));
+    Planet* light = ObjectFactory::makePlanet(
+        "light", 7e22, makeVector2(1e15 + 6e6, 0), makeVector2(-1e3, 2e4));
+    Planet* bystander
+        = ObjectFactory::makePlanet("bystander", 1e22, makeVector2(-1e15, 0), makeVector2());
+    heavy->setRadius(6.4e6);
+    light->setRadius(1.7e6);
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    univ->setCollisionMode(Universe::CollisionMode::Merge);
+    const Vector2 momentum = 6e24 * heavy->getVelocity() + 7e22 * light->getVelocity();
+    const Vector2 center = (6e24 * heavy->getPosition() + 7e22 * light->getPosition()) / 6.07e24;
+    univ->stepSimulation(1.0);
+
+    // The light body is gone, the heavy one carries on with the sum
+    ASSERT_EQ(univ->getBodies().size(), 3U);
+    EXPECT_EQ(*(univ->begin() + 1), heavy);
+    EXPECT_EQ(*(univ->begin() + 2), bystander);
+    EXPECT_DOUBLE_EQ(heavy->getMass(), 6.07e24);
+    EXPECT_DOUBLE_EQ(heavy->getRadius(), std::cbrt(6.4e6 * 6.4e6 * 6.4e6 + 1.7e6 * 1.7e6 * 1.7e6));
+    assertVector(heavy->getMass() * heavy->getVelocity(), momentum, 1e-6 * momentum.norm());
+    assertVector(heavy->getPosition(), center + heavy->getVelocity(), 10.0);
+    EXPECT_EQ(bystander->getPosition(), univ->getBodies().getPosition(2));
+
+    // The absorbed object keeps its last state
+    EXPECT_DOUBLE_EQ(light->getMass(), 7e22);
+    EXPECT_EQ(light->getRadius(), 1.7e6);
+
+    ASSERT_EQ(univ->getCollisionEvents().size(), 1U);
+    const CollisionEvent& event = univ->getCollisionEvents()[0];
+    EXPECT_EQ(event.first, "heavy");
+    EXPECT_EQ(event.second, "light");
+    EXPECT_TRUE(event.impact);
+    EXPECT_TRUE(event.merged);
+    EXPECT_DOUBLE_EQ(event.time, 1.0);
+    univ->clearCollisionEvents();
+    EXPECT_TRUE(univ->getCollisionEvents().empty());
+}
+
+TEST_F(CollisionsTest, RecordModeOnlyLogs)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Object* sun = ObjectFactory::makeSun();
+    sun->setRadius(7e8);
+    Planet* grazer
+        = ObjectFactory::makePlanet("grazer", 1e23, makeVector2(7.5e8, 0), makeVector2(0, 4e5));
+    ObjectFactory::makePlanet("earth", 6e24, makeVector2(1.5e11, 0), makeVector2(0, 3e4));
+    ObjectFactory::makePlanet("moon", 7e22, makeVector2(1.5e11 + 3.8e8, 0), makeVector2(0, 3.1e4));
+
+    // Passes within the encounter distance are logged but not merged
+    univ->setCollisionMode(Universe::CollisionMode::Record);
+    univ->setEncounterDistance(4e8);
+    EXPECT_EQ(univ->getEncounterDistance(), 4e8);
+    univ->stepSimulation(1.0);
+    ASSERT_EQ(univ->getCollisionEvents().size(), 2U);
+    EXPECT_EQ(univ->getCollisionEvents()[0].second, "grazer");
+    EXPECT_FALSE(univ->getCollisionEvents()[0].impact);
+    EXPECT_EQ(univ->getCollisionEvents()[1].first, "earth");
+    EXPECT_FALSE(univ->getCollisionEvents()[1].merged);
+    EXPECT_EQ(univ->getBodies().size(), 4U);
+
+    // The sun swallows a body in Merge mode without moving
+    univ->setEncounterDistance(0.0);
+    univ->setCollisionMode(Universe::CollisionMode::Merge);
+    grazer->setPosition(makeVector2(6e8, 0));
+    univ->stepSimulation(1.0);
+    EXPECT_EQ(univ->getBodies().size(), 3U);
+    EXPECT_DOUBLE_EQ(sun->getMass(), 1.98892e30 + 1e23);
+    EXPECT_EQ(sun->getPosition(), makeVector2());
+    EXPECT_EQ((*(univ->begin() + 1))->getName(), "earth");
+    EXPECT_EQ(univ->getCollisionEvents().back().second, "grazer");
+    EXPECT_TRUE(univ->getCollisionEvents().back().merged);
+}
@@ -0,0 +1,66 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "objects/object.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "parser.h"
+#include "solvers/direct_solver.h"
+#include "universe.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+// The fixture for testing the pairwise direct force solver.
+class DirectSolverTest : public ::testing::Test { };
+
+TEST_F(DirectSolverTest, PairPassMatchesPerBodySums)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/extended_solar_system.json");
+    makeAsteroidBelt(50);
+
+    const BodyStore& bodies = univ->getBodies();
+    std::vector<double> ax(bodies.size());
+    std::vector<double> ay(bodies.size());
+    DirectSolver solver;
+    solver.computeAccelerations(bodies, ax.data(), ay.data());
+
+    std::size_t slot = 0;
+    for (const Object* obj : *univ) {
+        Vector2 force;
+        for (const Object* other : *univ) {
+            if (other != obj)
+                force += obj->getForce(*other);
+        }
+        if (slot == 0) {
+            // The fixed sun is not a target
+            EXPECT_EQ(ax[0], 0.0);
+            EXPECT_EQ(ay[0], 0.0);
+        } else {
+            const Vector2 expected = force / obj->getMass();
+            assertVector(makeVector2(ax[slot], ay[slot]), expected, expected.norm() * 1e-12);
+        }
+        ++slot;
+    }
+}
+
+TEST_F(DirectSolverTest, OppositeForcesBetweenFreeBodies)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeStar("far-sun", 1e30);
+    const Object* a
+        = ObjectFactory::makePlanet("a", 2e24, makeVector2(1e20, 0), makeVector2(0, 0));
+    const Object* b
+        = ObjectFactory::makePlanet("b", 6e24, makeVector2(1e20, 1e9), makeVector2(0, 0));
+
+    const BodyStore& bodies = univ->getBodies();
+    std::vector<double> ax(bodies.size());
+    std::vector<double> ay(bodies.size());
+    DirectSolver solver;
+    solver.computeAccelerations(bodies, ax.data(), ay.data());
+
+    // m_a * a_a == -m_b * a_b along the line joining them, up to the far sun's pull
+    const double pullOnA = a->getMass() * ay[1];
+    EXPECT_NEAR(pullOnA, -b->getMass() * ay[2], 1e-9 * std::abs(pullOnA));
+    EXPECT_GT(ay[1], 0.0);
+}
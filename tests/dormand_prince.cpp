@@ -0,0 +1,165 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "integrators/dormand_prince.h"
+#include "integrators/leapfrog.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "universe.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing the adaptive Dormand-Prince integrator.
+class DormandPrinceTest : public ::testing::Test { };
+
+namespace {
+
+constexpr double PERIHELION = 1e11; // Closest approach of the test orbit
+constexpr double SEMI_MAJOR = 5.5e11; // Aphelion at 1e12 m, a seven year period
+
+/**
+ * Puts a planet at the perihelion of an orbit with eccentricity 0.82 and
+ * returns its period
+ */
+double makeEccentricOrbit()
+{
+    const Object* sun = ObjectFactory::makeSun();
+    const double mu = Universe::G * sun->getMass();
+    const double speed = std::sqrt(mu * (2.0 / PERIHELION - 1.0 / SEMI_MAJOR));
+    ObjectFactory::makePlanet("planet", 1e22, makeVector2(PERIHELION, 0), makeVector2(0, speed));
+    return 2.0 * std::numbers::pi * std::sqrt(SEMI_MAJOR * SEMI_MAJOR * SEMI_MAJOR / mu);
+}
+
+/**
+ * Runs one period of the eccentric orbit and returns how far the planet ends
+ * up from where it started
+ * @param integrator - scheme to step with
+ * @param dt - requested time step, rounded so the run spans one period
+ * @param evaluations - receives the number of force evaluations
+ */
+double eccentricError(std::unique_ptr<Integrator> integrator, double dt, std::size_t& evaluations)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    const double period = makeEccentricOrbit();
+    univ->setIntegrator(std::move(integrator));
+    const long steps = std::max(1L, std::lround(period / dt));
+    for (long i = 0; i < steps; ++i)
+        univ->stepSimulation(period / static_cast<double>(steps));
+    evaluations = univ->getIntegrator().getForceEvaluations();
+    return (univ->getBodies().getPosition(1) - makeVector2(PERIHELION, 0)).norm();
+}
+
+} // anonymous namespace
+
+TEST_F(DormandPrinceTest, FewerEvaluationsThanFixedSteps)
+{
+    std::size_t leapfrog = 0;
+    std::size_t adaptive = 0;
+    const double fixedError
+        = eccentricError(std::make_unique<LeapfrogIntegrator>(), 3600, leapfrog);
+    // One call for the whole orbit, the integrator picks its own steps
+    const double adaptiveError
+        = eccentricError(std::make_unique<DormandPrinceIntegrator>(1e-8), 1e12, adaptive);
+
+    EXPECT_LT(adaptiveError, fixedError / 10);
+    EXPECT_LT(adaptive * 50, leapfrog);
+}
+
+TEST_F(DormandPrinceTest, ToleranceControlsError)
+{
+    std::size_t evaluations = 0;
+    double previous = 1e300;
+    std::size_t cost = 0;
+    for (const double tolerance : { 1e-6, 1e-8, 1e-10, 1e-12 }) {
+        const double error = eccentricError(
+            std::make_unique<DormandPrinceIntegrator>(tolerance), 1e12, evaluations);
+        EXPECT_LT(error, previous / 10);
+        EXPECT_GT(evaluations, cost);
+        previous = error;
+        cost = evaluations;
+    }
+    EXPECT_LT(previous, 1e3);
+}
+
+TEST_F(DormandPrinceTest, DenseOutputIsFree)
+{
+    std::vector<double> samples;
+    for (int k = 0; k <= 100; ++k)
+        samples.push_back(k * 1e6);
+
+    std::size_t plain = 0;
+    Vector2 end;
+    {
+        const std::unique_ptr<Universe> univ(Universe::instance());
+        makeEccentricOrbit();
+        univ->setIntegrator(std::make_unique<DormandPrinceIntegrator>());
+        univ->advanceTo(1e8);
+        plain = univ->getIntegrator().getForceEvaluations();
+        end = univ->getBodies().getPosition(1);
+    }
+
+    std::vector<double> times;
+    std::vector<Vector2> positions;
+    {
+        const std::unique_ptr<Universe> univ(Universe::instance());
+        makeEccentricOrbit();
+        univ->setIntegrator(std::make_unique<DormandPrinceIntegrator>());
+        univ->advanceTo(1e8, samples, [&](double time, const BodyStore& state) {
+            times.push_back(time);
+            positions.push_back(state.getPosition(1));
+        });
+        EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), plain);
+        EXPECT_DOUBLE_EQ(univ->getTime(), 1e8);
+        EXPECT_TRUE(univ->getBodies().getPosition(1) == end);
+    }
+    ASSERT_EQ(times, samples);
+    EXPECT_TRUE(positions.front() == makeVector2(PERIHELION, 0));
+    EXPECT_TRUE(positions.back() == end);
+
+    // Each sample agrees with a run that stops right there
+    for (const std::size_t k : { 7u, 33u, 61u }) {
+        const std::unique_ptr<Universe> univ(Universe::instance());
+        makeEccentricOrbit();
+        univ->setIntegrator(std::make_unique<DormandPrinceIntegrator>(1e-12));
+        univ->advanceTo(samples[k]);
+        assertVector(positions[k], univ->getBodies().getPosition(1), 1e3);
+    }
+}
+
+TEST_F(DormandPrinceTest, AdvancesBackwards)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    const Object* earth = ObjectFactory::makeEarth();
+    ObjectFactory::makeJupiter();
+    const Vector2 start = earth->getPosition();
+
+    univ->setIntegrator(std::make_unique<DormandPrinceIntegrator>(1e-12));
+    univ->advanceTo(1e8);
+    EXPECT_GT((earth->getPosition() - start).norm(), 1e10);
+    univ->advanceTo(0);
+    assertVector(earth->getPosition(), start, 1e3);
+    EXPECT_EQ(univ->getTime(), 0.0);
+}
+
+TEST_F(DormandPrinceTest, RejectsInvalidConfiguration)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeEarth();
+    EXPECT_THROW(DormandPrinceIntegrator(0.0), std::logic_error);
+    // advanceTo needs an integrator that picks its own steps
+    EXPECT_THROW(univ->advanceTo(86400), std::logic_error);
+
+    univ->setIntegrator(std::make_unique<DormandPrinceIntegrator>());
+    auto ignore = [](double, const BodyStore&) { };
+    EXPECT_THROW(univ->advanceTo(86400, { 2 * 86400.0 }, ignore), std::logic_error);
+    EXPECT_THROW(univ->advanceTo(86400, { 2.0, 1.0 }, ignore), std::logic_error);
+    univ->stepSimulation(3600);
+    EXPECT_DOUBLE_EQ(univ->getTime(), 3600.0);
+}
@@ -0,0 +1,107 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "ensemble_runner.h"
+#include "integrators/leapfrog.h"
+#include "objects/object.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "parser.h"
+#include "universe.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing independent Universes and the ensemble runner.
+class EnsembleTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Loads the solar system with the earth sped up by index meters per second
+ * @param universe - universe to fill
+ * @param index - member of the ensemble
+ */
+void perturbedSolarSystem(Universe& universe, std::size_t index)
+{
+    Parser::loadFile(universe, "../tests/solar_system.json");
+    universe.setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    Object* earth = *(universe.begin() + 3);
+    earth->setVelocity(earth->getVelocity() * (1.0 + 1e-4 * static_cast<double>(index)));
+}
+
+} // anonymous namespace
+
+TEST_F(EnsembleTest, UniversesAreIndependent)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    const Planet* shared = ObjectFactory::makeEarth();
+
+    {
+        Universe first;
+        Universe second;
+        ObjectFactory::makeSun(first);
+        ObjectFactory::makeSun(second);
+        const Planet* fast = ObjectFactory::makePlanet(
+            second, "fast", 6e24, makeVector2(1.5e11, 0), makeVector2(0, 4e4));
+        const Planet* slow = ObjectFactory::makePlanet(
+            first, "slow", 6e24, makeVector2(1.5e11, 0), makeVector2(0, 2e4));
+        first.stepSimulation(86400);
+        second.stepSimulation(86400);
+
+        EXPECT_EQ(first.getBodies().size(), 2U);
+        EXPECT_EQ(second.getBodies().size(), 2U);
+        EXPECT_EQ(*(first.begin() + 1), slow);
+        EXPECT_EQ(*(second.begin() + 1), fast);
+        EXPECT_NE(slow->getPosition(), fast->getPosition());
+        EXPECT_EQ(first.getTime(), 86400.0);
+    }
+
+    // The process wide Universe outlives the others untouched
+    EXPECT_EQ(Universe::instance(), univ.get());
+    EXPECT_EQ(univ->getBodies().size(), 2U);
+    EXPECT_EQ(univ->getTime(), 0.0);
+    EXPECT_EQ(shared->getPosition(), univ->getBodies().getPosition(1));
+}
+
+TEST_F(EnsembleTest, MembersMatchSerialRuns)
+{
+    EnsembleRunner runner(3);
+    EXPECT_EQ(runner.getThreadCount(), 3U);
+    std::vector<Vector2> earths(10);
+    const std::vector<EnsembleMember> members = runner.run(
+        10,
+        [](Universe& universe, std::size_t index) {
+            if (index == 7)
+                throw std::logic_error("bad member");
+            perturbedSolarSystem(universe, index);
+        },
+        3600, 240,
+        [&earths](Universe& universe, std::size_t index) {
+            earths[index] = (*(universe.begin() + 3))->getPosition();
+        });
+
+    ASSERT_EQ(members.size(), 10U);
+    for (std::size_t index = 0; index < members.size(); ++index) {
+        const EnsembleMember& member = members[index];
+        EXPECT_EQ(member.index, index);
+        if (index == 7) {
+            EXPECT_EQ(member.error, "bad member");
+            EXPECT_EQ(member.state.size(), 0U);
+            continue;
+        }
+        EXPECT_TRUE(member.error.empty());
+        EXPECT_EQ(member.time, 3600.0 * 240);
+
+        // Every member has the bits of the same run on its own
+        Universe alone;
+        perturbedSolarSystem(alone, index);
+        alone.advance(3600, 240);
+        EXPECT_EQ(member.state.getPosition(3), alone.getBodies().getPosition(3));
+        EXPECT_EQ(earths[index], member.state.getPosition(3));
+    }
+    EXPECT_NE(members[0].state.getPosition(3), members[1].state.getPosition(3));
+    EXPECT_THROW(EnsembleRunner(0), std::logic_error);
+}
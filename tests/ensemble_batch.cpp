@@ -0,0 +1,103 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "ensemble_batch.h"
+#include "integrators/leapfrog.h"
+#include "objects/object.h"
+#include "parser.h"
+#include "universe.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+
+// The fixture for testing the vectorized ensemble of small systems.
+class EnsembleBatchTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Returns the velocity of the earth in the given member
+ * @param bodies - unperturbed solar system
+ * @param index - member of the ensemble
+ */
+Vector2 perturbedEarth(const BodyStore& bodies, std::size_t index)
+{
+    return bodies.getVelocity(3) * (1.0 + 1e-4 * static_cast<double>(index));
+}
+
+/**
+ * Loads the perturbed solar system of one member into a Universe of its own
+ * @param universe - universe to fill
+ * @param index - member of the ensemble
+ */
+void loadMember(Universe& universe, std::size_t index)
+{
+    Parser::loadFile(universe, "../tests/solar_system.json");
+    universe.setDeterministic(true);
+    universe.setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    Object* earth = *(universe.begin() + 3);
+    earth->setVelocity(perturbedEarth(universe.getBodies(), index));
+}
+
+} // anonymous namespace
+
+TEST_F(EnsembleBatchTest, MembersMatchUniverses)
+{
+    BodyStore system;
+    Parser::loadBodies("../tests/solar_system.json", system);
+    const std::size_t members = 11;
+
+    for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        EnsembleBatch stepped(system, members);
+        EnsembleBatch advanced(system, members);
+        stepped.setLevel(level);
+        advanced.setLevel(level);
+        EXPECT_EQ(stepped.getLevel(), std::min(level, SimdSolver::detect()));
+        for (std::size_t index = 0; index < members; ++index) {
+            stepped.setVelocity(index, 3, perturbedEarth(system, index));
+            advanced.setVelocity(index, 3, perturbedEarth(system, index));
+        }
+        for (int i = 0; i < 50; ++i)
+            stepped.step(3600);
+        advanced.advance(3600, 50);
+        EXPECT_EQ(stepped.getTime(), 3600.0 * 50);
+        EXPECT_EQ(advanced.getTime(), 3600.0 * 50);
+
+        for (std::size_t index = 0; index < members; ++index) {
+            Universe alone;
+            loadMember(alone, index);
+            Universe batched;
+            loadMember(batched, index);
+            for (int i = 0; i < 50; ++i)
+                alone.stepSimulation(3600);
+            batched.advance(3600, 50);
+
+            const BodyStore member = stepped.getMember(index);
+            ASSERT_EQ(member.size(), alone.getBodies().size());
+            for (std::size_t slot = 0; slot < member.size(); ++slot) {
+                EXPECT_EQ(member.getPosition(slot), alone.getBodies().getPosition(slot));
+                EXPECT_EQ(member.getVelocity(slot), alone.getBodies().getVelocity(slot));
+                EXPECT_EQ(advanced.getPosition(index, slot), batched.getBodies().getPosition(slot));
+                EXPECT_EQ(advanced.getVelocity(index, slot), batched.getBodies().getVelocity(slot));
+            }
+            EXPECT_EQ(member.getMass(3), alone.getBodies().getMass(3));
+        }
+        EXPECT_NE(stepped.getPosition(0, 3), stepped.getPosition(1, 3));
+    }
+}
+
+TEST_F(EnsembleBatchTest, RejectsBadMembers)
+{
+    BodyStore system;
+    Parser::loadBodies("../tests/solar_system.json", system);
+    EXPECT_THROW(EnsembleBatch(system, 0), std::logic_error);
+
+    EnsembleBatch batch(system, 3);
+    EXPECT_EQ(batch.getMemberCount(), 3U);
+    EXPECT_EQ(batch.getBodyCount(), system.size());
+    EXPECT_EQ(batch.getPosition(2, 3), system.getPosition(3));
+    EXPECT_THROW((void)batch.getPosition(3, 0), std::logic_error);
+    EXPECT_THROW(batch.setVelocity(0, system.size(), makeVector2(0, 0)), std::logic_error);
+    EXPECT_THROW((void)batch.getMember(3), std::logic_error);
+}
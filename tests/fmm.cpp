@@ -0,0 +1,74 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "objects/object_factory.h"
+#include "solvers/fmm.h"
+#include "universe.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+// The fixture for testing the Fast Multipole Method force solver.
+class FmmTest : public ::testing::Test { };
+
+TEST_F(FmmTest, ErrorShrinksWithOrder)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(1000);
+
+    FmmSolver low(4);
+    FmmSolver high(12);
+    const ForceError lowError = low.validate(univ->getBodies());
+    const ForceError highError = high.validate(univ->getBodies());
+    EXPECT_GE(high.getDepth(), 2u);
+    EXPECT_LT(highError.maxRelative, lowError.maxRelative);
+    EXPECT_LT(highError.rmsRelative, lowError.rmsRelative);
+    EXPECT_LT(highError.maxRelative, 1e-3);
+}
+
+TEST_F(FmmTest, ToleranceSelectsOrder)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    makeAsteroidBelt(600);
+
+    FmmSolver solver;
+    solver.setTolerance(1e-5);
+    EXPECT_GT(solver.getOrder(), 12u);
+    const ForceError error = solver.validate(univ->getBodies());
+    EXPECT_LT(error.maxRelative, 1e-5);
+
+    solver.setTolerance(0.1);
+    EXPECT_EQ(solver.getOrder(), 4u);
+}
+
+TEST_F(FmmTest, SelectableOnUniverseWithValidation)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeEarth();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(300);
+
+    auto solver = std::make_unique<FmmSolver>(10);
+    solver->setLeafSize(16);
+    solver->setValidation(true);
+    univ->setForceSolver(std::move(solver));
+    for (int i = 0; i < 3; ++i)
+        univ->stepSimulation(3600);
+
+    const ForceError& error = univ->getForceSolver().getLastError();
+    EXPECT_GT(error.maxRelative, 0.0);
+    EXPECT_LT(error.maxRelative, 1e-3);
+}
+
+TEST_F(FmmTest, RejectsInvalidConfiguration)
+{
+    EXPECT_THROW(FmmSolver(0), std::logic_error);
+    EXPECT_THROW(FmmSolver(FmmSolver::MAX_ORDER + 1), std::logic_error);
+    FmmSolver solver;
+    EXPECT_THROW(solver.setLeafSize(0), std::logic_error);
+    EXPECT_THROW(solver.setTolerance(0.0), std::logic_error);
+    EXPECT_THROW(solver.setTolerance(1.0), std::logic_error);
+}
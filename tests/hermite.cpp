@@ -0,0 +1,137 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "integrators/hermite.h"
+#include "integrators/yoshida.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "universe.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing the block time step Hermite integrator.
+class HermiteTest : public ::testing::Test { };
+
+namespace {
+
+constexpr double BLOCK = 4194304.0; // 2^22 seconds, about 48.5 days
+
+/**
+ * Creates the sun, Mercury, Neptune, a comet leaving perihelion on a seventy
+ * year orbit and a belt of asteroids
+ */
+void makeMixedPopulation()
+{
+    ObjectFactory::makeSun();
+    ObjectFactory::makeMercury();
+    ObjectFactory::makeNeptune();
+    ObjectFactory::makeComet("comet", 1e14, makeVector2(1e11, 0), makeVector2(0, 51010), "ice");
+    makeAsteroidBelt(50);
+}
+
+/**
+ * Runs the mixed population for eight blocks and returns the final positions
+ * @param integrator - scheme to step with
+ * @param dt - time step
+ * @param threads - number of threads of the universe
+ */
+std::vector<Vector2> runMixed(
+    std::unique_ptr<Integrator> integrator, double dt, std::size_t threads)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    makeMixedPopulation();
+    univ->setThreadCount(threads);
+    univ->setIntegrator(std::move(integrator));
+    const long steps = std::lround(8 * BLOCK / dt);
+    for (long i = 0; i < steps; ++i)
+        univ->stepSimulation(dt);
+
+    std::vector<Vector2> positions;
+    for (const Object* object : *univ)
+        positions.push_back(object->getPosition());
+    return positions;
+}
+
+} // anonymous namespace
+
+TEST_F(HermiteTest, StepsFollowTheBodies)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    makeMixedPopulation();
+    univ->setIntegrator(std::make_unique<HermiteIntegrator>());
+    auto& hermite = dynamic_cast<HermiteIntegrator&>(univ->getIntegrator());
+    for (int i = 0; i < 8; ++i)
+        univ->stepSimulation(BLOCK);
+
+    // Every step is the block divided by a power of two
+    double smallest = BLOCK;
+    const std::size_t count = univ->getBodies().size();
+    for (std::size_t slot = 1; slot < count; ++slot) {
+        const double step = hermite.getTimeStep(slot);
+        const double exponent = std::log2(BLOCK / step);
+        EXPECT_DOUBLE_EQ(exponent, std::round(exponent));
+        smallest = std::min(smallest, hermite.getTimeStep(slot));
+    }
+    // Mercury needs much shorter steps than Neptune or the belt
+    EXPECT_EQ(hermite.getTimeStep(1), smallest);
+    EXPECT_LE(hermite.getTimeStep(1) * 16, hermite.getTimeStep(2));
+    EXPECT_LE(hermite.getTimeStep(1) * 16, hermite.getTimeStep(4));
+
+    // A shared step would evaluate every body at Mercury's pace
+    const double shared = 8 * BLOCK / smallest * static_cast<double>(count - 1);
+    EXPECT_LT(static_cast<double>(hermite.getBodyEvaluations()), shared / 5);
+    EXPECT_GE(hermite.getBlockCount(), static_cast<std::uint64_t>(8 * BLOCK / smallest));
+}
+
+TEST_F(HermiteTest, MatchesFineReference)
+{
+    const std::vector<Vector2> reference
+        = runMixed(std::make_unique<YoshidaIntegrator>(6), BLOCK / 1024, 1);
+    const std::vector<Vector2> hermite = runMixed(std::make_unique<HermiteIntegrator>(), BLOCK, 1);
+    ASSERT_EQ(reference.size(), hermite.size());
+    // About 400 days, Mercury accumulates the largest phase error
+    for (std::size_t slot = 1; slot < reference.size(); ++slot)
+        assertVector(hermite[slot], reference[slot], 1e8);
+}
+
+TEST_F(HermiteTest, ParallelMatchesSerial)
+{
+    const std::vector<Vector2> serial = runMixed(std::make_unique<HermiteIntegrator>(), BLOCK, 1);
+    const std::vector<Vector2> parallel = runMixed(std::make_unique<HermiteIntegrator>(), BLOCK, 4);
+    ASSERT_EQ(serial.size(), parallel.size());
+    // Each body's sum runs in the same order on any worker
+    for (std::size_t slot = 0; slot < serial.size(); ++slot)
+        EXPECT_TRUE(serial[slot] == parallel[slot]);
+}
+
+TEST_F(HermiteTest, RestartsAfterManualChanges)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    Object* earth = ObjectFactory::makeEarth();
+    univ->setIntegrator(std::make_unique<HermiteIntegrator>());
+    auto& hermite = dynamic_cast<HermiteIntegrator&>(univ->getIntegrator());
+
+    univ->stepSimulation(86400);
+    const std::uint64_t first = hermite.getBodyEvaluations();
+    univ->stepSimulation(86400);
+    const std::uint64_t second = hermite.getBodyEvaluations() - first;
+    // The start of a step reuses the end of the previous one
+    EXPECT_LT(second, first);
+
+    // Changing a velocity by hand starts over
+    earth->setVelocity(earth->getVelocity() * 1.01);
+    univ->stepSimulation(86400);
+    EXPECT_EQ(hermite.getBodyEvaluations() - first - second, first);
+}
+
+TEST_F(HermiteTest, RejectsInvalidAccuracy)
+{
+    EXPECT_THROW(HermiteIntegrator(0.0), std::logic_error);
+    EXPECT_THROW(HermiteIntegrator(1.0), std::logic_error);
+    EXPECT_DOUBLE_EQ(HermiteIntegrator(0.05).getEta(), 0.05);
+}
@@ -0,0 +1,214 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "integrators/euler.h"
+#include "integrators/leapfrog.h"
+#include "integrators/yoshida.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "solvers/barnes_hut.h"
+#include "solvers/direct_solver.h"
+#include "universe.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numbers>
+#include <stdexcept>
+
+// The fixture for testing the time integrators.
+class IntegratorTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Runs a planet on a circular one AU orbit for whole periods and returns how
+ * far it ends up from where it started
+ * @param integrator - scheme to step with
+ * @param dt - requested time step, rounded so the run spans whole periods
+ * @param periods - number of orbits to run
+ */
+double orbitError(std::unique_ptr<Integrator> integrator, double dt, int periods)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    const Object* sun = ObjectFactory::makeSun();
+    const double mu = Universe::G * sun->getMass();
+    const double radius = 1.496e11;
+    const Object* planet = ObjectFactory::makePlanet(
+        "planet", 1e22, makeVector2(radius, 0), makeVector2(0, std::sqrt(mu / radius)));
+    univ->setIntegrator(std::move(integrator));
+
+    const double period = 2.0 * std::numbers::pi * std::sqrt(radius * radius * radius / mu);
+    const double total = periods * period;
+    const long steps = std::lround(total / dt);
+    for (long i = 0; i < steps; ++i)
+        univ->stepSimulation(total / static_cast<double>(steps));
+    return (planet->getPosition() - makeVector2(radius, 0)).norm();
+}
+
+} // anonymous namespace
+
+TEST_F(IntegratorTest, LargerStepsBeatHourlyEuler)
+{
+    const double hour = 3600.0;
+    const double day = 24 * hour;
+    const double euler = orbitError(std::make_unique<EulerIntegrator>(), hour, 10);
+    const double leapfrog = orbitError(std::make_unique<LeapfrogIntegrator>(), day, 10);
+    const double yoshida4 = orbitError(std::make_unique<YoshidaIntegrator>(4), 4 * day, 10);
+    const double yoshida6 = orbitError(std::make_unique<YoshidaIntegrator>(6), 10 * day, 10);
+
+    // Ten years at 24x, 96x and 240x the step, still far more accurate
+    EXPECT_GT(euler, 1e11);
+    EXPECT_LT(leapfrog, euler / 100);
+    EXPECT_LT(yoshida4, euler / 1000);
+    EXPECT_LT(yoshida6, euler / 10000);
+}
+
+TEST_F(IntegratorTest, ConvergenceOrder)
+{
+    const double day = 86400.0;
+    auto ratio = [day](auto make) {
+        return orbitError(make(), 4 * day, 1) / orbitError(make(), 2 * day, 1);
+    };
+    // Halving the step divides the error by 2^order
+    const double leapfrog = ratio([] { return std::make_unique<LeapfrogIntegrator>(); });
+    const double yoshida4 = ratio([] { return std::make_unique<YoshidaIntegrator>(4); });
+    const double yoshida6 = ratio([] { return std::make_unique<YoshidaIntegrator>(6); });
+    EXPECT_NEAR(leapfrog, 4.0, 0.5);
+    EXPECT_NEAR(yoshida4, 16.0, 4.0);
+    EXPECT_NEAR(yoshida6, 64.0, 16.0);
+}
+
+TEST_F(IntegratorTest, ForcesAreReusedBetweenKicks)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    Object* earth = ObjectFactory::makeEarth();
+    ObjectFactory::makeMars();
+
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    for (int i = 0; i < 10; ++i)
+        univ->stepSimulation(86400);
+    // The closing kick of a step opens the next one
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 11u);
+
+    // Moving a body by hand invalidates the cache
+    earth->setPosition(earth->getPosition() * 1.01);
+    univ->stepSimulation(86400);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 13u);
+
+    univ->setIntegrator(std::make_unique<YoshidaIntegrator>(6));
+    for (int i = 0; i < 10; ++i)
+        univ->stepSimulation(86400);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 71u);
+
+    univ->setIntegrator(std::make_unique<EulerIntegrator>());
+    for (int i = 0; i < 10; ++i)
+        univ->stepSimulation(86400);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 10u);
+}
+
+TEST_F(IntegratorTest, SolverSettingsInvalidateForces)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeEarth();
+    ObjectFactory::makeMars();
+
+    univ->setForceSolver(std::make_unique<BarnesHutSolver>());
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    univ->stepSimulation(86400);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 2u);
+
+    // The opening kick must not reuse forces computed with the old angle
+    auto& solver = dynamic_cast<BarnesHutSolver&>(univ->getForceSolver());
+    solver.setTheta(0.0);
+    univ->stepSimulation(86400);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 4u);
+
+    univ->setDeterministic(true);
+    univ->stepSimulation(86400);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 6u);
+
+    // Unchanged settings keep the cache
+    univ->stepSimulation(86400);
+    EXPECT_EQ(univ->getIntegrator().getForceEvaluations(), 7u);
+}
+
+TEST_F(IntegratorTest, CompositionIsTimeReversible)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    const Object* earth = ObjectFactory::makeEarth();
+    ObjectFactory::makeJupiter();
+    const Vector2 start = earth->getPosition();
+
+    univ->setIntegrator(std::make_unique<YoshidaIntegrator>(4));
+    for (int i = 0; i < 100; ++i)
+        univ->stepSimulation(86400);
+    EXPECT_GT((earth->getPosition() - start).norm(), 1e10);
+    for (int i = 0; i < 100; ++i)
+        univ->stepSimulation(-86400);
+    assertVector(earth->getPosition(), start, 1.0);
+}
+
+TEST_F(IntegratorTest, RejectsInvalidConfiguration)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    EXPECT_THROW(YoshidaIntegrator(5), std::logic_error);
+    EXPECT_THROW(univ->setIntegrator(nullptr), std::logic_error);
+    EXPECT_EQ(YoshidaIntegrator(6).getOrder(), 6u);
+}
+
+TEST_F(IntegratorTest, CompensationKeepsTinyIncrements)
+{
+    // Each step moves the body by a third of the spacing of doubles around it
+    const double start = 1.5e11;
+    const double speed = 1e-5;
+    const std::size_t steps = 100000;
+    auto run = [&](std::unique_ptr<Integrator> integrator, bool compensated, bool batched) {
+        BodyStore bodies;
+        bodies.add(0.0, makeVector2(), makeVector2());
+        bodies.add(1.0, makeVector2(start, 0), makeVector2(speed, 0));
+        DirectSolver solver;
+        integrator->setCompensation(compensated);
+        EXPECT_EQ(integrator->getCompensation(), compensated);
+        if (batched) {
+            integrator->advance(bodies, solver, 1.0, steps);
+        } else {
+            for (std::size_t n = 0; n < steps; ++n)
+                integrator->step(bodies, solver, 1.0);
+        }
+        return bodies.x()[1];
+    };
+
+    const double expected = start + speed * static_cast<double>(steps);
+    for (bool batched : { false, true }) {
+        EXPECT_EQ(run(std::make_unique<EulerIntegrator>(), false, batched), start);
+        EXPECT_EQ(run(std::make_unique<LeapfrogIntegrator>(), false, batched), start);
+        EXPECT_NEAR(run(std::make_unique<EulerIntegrator>(), true, batched), expected, 1e-4);
+        EXPECT_NEAR(run(std::make_unique<LeapfrogIntegrator>(), true, batched), expected, 1e-4);
+    }
+}
+
+TEST_F(IntegratorTest, CompensationRestartsAfterExternalChange)
+{
+    BodyStore bodies;
+    bodies.add(1.98892e30, makeVector2(), makeVector2());
+    bodies.add(5.9722e24, makeVector2(1.496e11, 0), makeVector2(0, 29780));
+    DirectSolver solver;
+    EulerIntegrator integrator;
+    integrator.setCompensation(true);
+    for (int i = 0; i < 10; ++i)
+        integrator.step(bodies, solver, 3600);
+
+    // Bits carried for the old state must not leak into the new one
+    bodies.setPosition(1, makeVector2(1.5e11, 1e9));
+    BodyStore copy = bodies;
+    EulerIntegrator fresh;
+    fresh.setCompensation(true);
+    integrator.step(bodies, solver, 3600);
+    fresh.step(copy, solver, 3600);
+    EXPECT_EQ(bodies.getPosition(1), copy.getPosition(1));
+    EXPECT_EQ(bodies.getVelocity(1), copy.getVelocity(1));
+}
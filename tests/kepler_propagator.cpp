@@ -0,0 +1,149 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "body_store.h"
+#include "integrators/dormand_prince.h"
+#include "integrators/kepler_propagator.h"
+#include "integrators/leapfrog.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "parser.h"
+#include "universe.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing the analytic Kepler propagation of weakly perturbed bodies.
+class KeplerPropagatorTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Runs the planets of solar_system.json for a year of hourly leapfrog steps
+ * and returns the final positions
+ * @param ratio - Kepler ratio of the universe
+ * @param onKepler - receives whether each body ended up on its Kepler orbit
+ */
+std::vector<Vector2> runPlanets(double ratio, std::vector<bool>& onKepler)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    univ->setKeplerRatio(ratio);
+    for (int hour = 0; hour < 24 * 365; ++hour)
+        univ->stepSimulation(3600);
+
+    std::vector<Vector2> positions;
+    onKepler.clear();
+    for (std::size_t slot = 0; slot < univ->getBodies().size(); ++slot) {
+        positions.push_back(univ->getBodies().getPosition(slot));
+        onKepler.push_back(univ->isOnKepler(slot));
+    }
+    return positions;
+}
+
+} // anonymous namespace
+
+TEST_F(KeplerPropagatorTest, JumpsToAnyTime)
+{
+    const double mu = Universe::G * 1.98892e30;
+    const double perihelion = 1e11;
+    const double semiMajor = 5.5e11;
+    const double speed = std::sqrt(mu * (2.0 / perihelion - 1.0 / semiMajor));
+    const double period
+        = 2.0 * std::numbers::pi * std::sqrt(semiMajor * semiMajor * semiMajor / mu);
+    BodyStore bodies;
+    bodies.add(mu / Universe::G, makeVector2(), makeVector2());
+    bodies.add(1.0, makeVector2(perihelion, 0), makeVector2(0, speed));
+    BodyStore reference = bodies;
+    reference.touch();
+
+    KeplerPropagator propagator;
+    const double epoch = 1e6;
+    propagator.reset(mu, makeVector2(), epoch);
+    propagator.add(1, bodies.getPosition(1), bodies.getVelocity(1));
+    EXPECT_EQ(propagator.size(), 1U);
+    EXPECT_EQ(propagator.getEpoch(), epoch);
+
+    // A thousand orbits ahead costs the same single solve as a month
+    const double month = 3e6;
+    propagator.propagate(epoch + month, bodies);
+    const Vector2 soon = bodies.getPosition(1);
+    propagator.propagate(epoch + 1000 * period + month, bodies);
+    assertVector(bodies.getPosition(1), soon, 100.0);
+
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    DormandPrinceIntegrator integrator(1e-13);
+    integrator.step(reference, univ->getForceSolver(), month);
+    assertVector(soon, reference.getPosition(1), 1e-8 * soon.norm());
+
+    // And back to the epoch
+    propagator.propagate(epoch, bodies);
+    assertVector(bodies.getPosition(1), makeVector2(perihelion, 0), 1.0);
+    assertVector(bodies.getVelocity(1), makeVector2(0, speed), 1e-6);
+}
+
+TEST_F(KeplerPropagatorTest, InnerPlanetsFollowOrbits)
+{
+    std::vector<bool> integrated;
+    const std::vector<Vector2> reference = runPlanets(0.0, integrated);
+    const double ratio = 1e-4;
+    std::vector<bool> onKepler;
+    const std::vector<Vector2> split = runPlanets(ratio, onKepler);
+
+    // Only the inner planets are disturbed by less than 1e-4 of the sun's pull
+    EXPECT_EQ(onKepler,
+        (std::vector<bool> { false, true, true, true, true, false, false, false, false }));
+    EXPECT_EQ(integrated, std::vector<bool>(9, false));
+
+    // The neglected pull displaces a body by at most ratio * a * t^2 / 2
+    const double mu = Universe::G * 1.98892e30;
+    const double year = 3600.0 * 24 * 365;
+    for (std::size_t slot = 1; slot < reference.size(); ++slot) {
+        const double pull = mu / reference[slot].normSq();
+        assertVector(split[slot], reference[slot], ratio * pull * year * year / 2);
+    }
+}
+
+TEST_F(KeplerPropagatorTest, FarParticlesSkipIntegration)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    const Object* jupiter = ObjectFactory::makeJupiter();
+    const double mu = Universe::G * 1.98892e30;
+    std::vector<Object*> cloud;
+    for (int i = 0; i < 100; ++i) {
+        const double radius = 1e13 * (1.0 + 0.02 * i);
+        const double angle = 0.7 * i;
+        const double speed = 0.9 * std::sqrt(mu / radius);
+        Object* comet = ObjectFactory::makeComet("cloud",
+            1e14, makeVector2(radius * std::cos(angle), radius * std::sin(angle)),
+            makeVector2(-speed * std::sin(angle), speed * std::cos(angle)), "ice");
+        comet->setTestParticle(true);
+        cloud.push_back(comet);
+    }
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    univ->setKeplerRatio(1e-2);
+    const Vector2 start = jupiter->getPosition();
+    univ->stepSimulation(86400);
+
+    // Jupiter and the cloud are all on their orbits
+    EXPECT_EQ(univ->getKeplerCount(), 101U);
+    EXPECT_NE(jupiter->getPosition(), start);
+    for (std::size_t slot = 1; slot < univ->getBodies().size(); ++slot)
+        EXPECT_TRUE(univ->isOnKepler(slot));
+
+    // Pushed next to Jupiter a comet is integrated again at the next step
+    cloud[0]->setPosition(jupiter->getPosition() + makeVector2(1e9, 0));
+    univ->stepSimulation(86400);
+    EXPECT_FALSE(univ->isOnKepler(2));
+    EXPECT_EQ(univ->getKeplerCount(), 100U);
+
+    univ->setKeplerRatio(0.0);
+    EXPECT_EQ(univ->getKeplerCount(), 0U);
+    EXPECT_FALSE(univ->isOnKepler(3));
+    EXPECT_THROW(univ->setKeplerRatio(-1.0), std::logic_error);
+}
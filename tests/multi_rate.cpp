@@ -0,0 +1,125 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "integrators/leapfrog.h"
+#include "parser.h"
+#include "solvers/multi_rate.h"
+#include "universe.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing the multi-rate force solver.
+class MultiRateTest : public ::testing::Test { };
+
+TEST_F(MultiRateTest, IntervalOneMatchesDirectSum)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    makeAsteroidBelt(300);
+
+    const BodyStore& bodies = univ->getBodies();
+    MultiRateSolver solver(1);
+    for (int i = 0; i < 3; ++i) {
+        const ForceError error = solver.validate(bodies);
+        EXPECT_LT(error.maxRelative, 1e-12);
+    }
+    const MultiRateStats& stats = solver.getStats();
+    EXPECT_EQ(stats.evaluations, 0U);
+
+    std::vector<double> ax(bodies.size());
+    std::vector<double> ay(bodies.size());
+    for (int i = 0; i < 3; ++i)
+        solver.computeAccelerations(bodies, ax.data(), ay.data());
+    EXPECT_EQ(stats.evaluations, 3U);
+    EXPECT_EQ(stats.refreshes, 3U);
+    // Every target sums the n - 1 other bodies
+    const std::size_t n = bodies.size();
+    EXPECT_EQ(stats.directPairs, 3 * (n - 1) * (n - 1));
+    EXPECT_EQ(stats.pairs, stats.directPairs);
+    EXPECT_EQ(solver.getReduction(), 0.0);
+}
+
+TEST_F(MultiRateTest, ValidateLeavesCachesAlone)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    makeAsteroidBelt(300);
+    const BodyStore& bodies = univ->getBodies();
+
+    // Without validate() in between, plain refreshes once in 6 evaluations
+    MultiRateSolver probed;
+    MultiRateSolver plain;
+    std::vector<double> ax(bodies.size());
+    std::vector<double> ay(bodies.size());
+    std::vector<double> bx(bodies.size());
+    std::vector<double> by(bodies.size());
+    for (int i = 0; i < 6; ++i) {
+        (void)probed.validate(bodies);
+        probed.computeAccelerations(bodies, ax.data(), ay.data());
+        plain.computeAccelerations(bodies, bx.data(), by.data());
+    }
+    EXPECT_EQ(probed.getStats().evaluations, 6U);
+    EXPECT_EQ(probed.getStats().refreshes, 1U);
+    EXPECT_EQ(probed.getStats().pairs, plain.getStats().pairs);
+    EXPECT_EQ(ax, bx);
+    EXPECT_EQ(ay, by);
+}
+
+TEST_F(MultiRateTest, ReusesSlowPullsBetweenRefreshes)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    makeAsteroidBelt(300);
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    auto solver = std::make_unique<MultiRateSolver>();
+    solver->setValidation(true);
+    univ->setForceSolver(std::move(solver));
+
+    double worst = 0.0;
+    for (int i = 0; i < 48; ++i) {
+        univ->stepSimulation(3600);
+        worst = std::max(worst, univ->getForceSolver().getLastError().maxRelative);
+    }
+    const auto& multiRate = dynamic_cast<const MultiRateSolver&>(univ->getForceSolver());
+    const MultiRateStats& stats = multiRate.getStats();
+    EXPECT_EQ(stats.evaluations, 49U);
+    EXPECT_GT(stats.refreshes, 1U);
+    EXPECT_LT(stats.refreshes, stats.evaluations / 4);
+    EXPECT_GT(multiRate.getReduction(), 0.5);
+    EXPECT_GT(worst, 0.0);
+    EXPECT_LT(worst, 1e-5);
+}
+
+TEST_F(MultiRateTest, DriftForcesEarlyRefresh)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    univ->setForceSolver(std::make_unique<MultiRateSolver>(1000, 0.5, 0.0));
+    for (int i = 0; i < 5; ++i)
+        univ->stepSimulation(3600);
+
+    auto& solver = dynamic_cast<MultiRateSolver&>(univ->getForceSolver());
+    EXPECT_EQ(solver.getStats().refreshes, solver.getStats().evaluations);
+    solver.resetStats();
+    solver.setDrift(1.0);
+    for (int i = 0; i < 5; ++i)
+        univ->stepSimulation(3600);
+    // The new setting costs the opening kick its cached forces
+    EXPECT_EQ(solver.getStats().evaluations, 6U);
+    EXPECT_EQ(solver.getStats().refreshes, 1U);
+}
+
+TEST_F(MultiRateTest, RejectsInvalidConfiguration)
+{
+    EXPECT_THROW(MultiRateSolver(0), std::logic_error);
+    EXPECT_THROW(MultiRateSolver(8, -0.1), std::logic_error);
+    EXPECT_THROW(MultiRateSolver(8, 0.5, -1.0), std::logic_error);
+    MultiRateSolver solver;
+    EXPECT_EQ(solver.getInterval(), 8U);
+    EXPECT_EQ(solver.getNearFactor(), 0.5);
+    EXPECT_EQ(solver.getDrift(), 0.05);
+}
@@ -0,0 +1,114 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "integrators/leapfrog.h"
+#include "objects/object_factory.h"
+#include "solvers/pruned_solver.h"
+#include "universe.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing the pruned interaction list solver.
+class PrunedSolverTest : public ::testing::Test { };
+
+TEST_F(PrunedSolverTest, ZeroThresholdMatchesDirectSum)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(300);
+
+    const BodyStore& bodies = univ->getBodies();
+    PrunedSolver solver(0.0, 1);
+    for (int i = 0; i < 2; ++i) {
+        const ForceError error = solver.validate(bodies);
+        EXPECT_LT(error.maxRelative, 1e-12);
+    }
+    // validate() is not an evaluation
+    EXPECT_EQ(solver.getStats().evaluations, 0U);
+
+    std::vector<double> ax(bodies.size());
+    std::vector<double> ay(bodies.size());
+    for (int i = 0; i < 2; ++i)
+        solver.computeAccelerations(bodies, ax.data(), ay.data());
+    EXPECT_EQ(solver.getStats().refreshes, 2U);
+    // Every target sums the n - 1 other bodies
+    const std::size_t n = bodies.size();
+    EXPECT_EQ(solver.getStats().directPairs, 2 * (n - 1) * (n - 1));
+    EXPECT_EQ(solver.getStats().pairs, solver.getStats().directPairs);
+    EXPECT_EQ(solver.getStats().neglectedRelative, 0.0);
+    EXPECT_EQ(solver.getStats().neglectedSum, 0.0);
+}
+
+TEST_F(PrunedSolverTest, ValidateLeavesListsAlone)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(300);
+    const BodyStore& bodies = univ->getBodies();
+
+    // Without validate() in between, plain rebuilds once in 10 evaluations
+    PrunedSolver probed;
+    PrunedSolver plain;
+    std::vector<double> ax(bodies.size());
+    std::vector<double> ay(bodies.size());
+    std::vector<double> bx(bodies.size());
+    std::vector<double> by(bodies.size());
+    for (int i = 0; i < 10; ++i) {
+        (void)probed.validate(bodies);
+        probed.computeAccelerations(bodies, ax.data(), ay.data());
+        plain.computeAccelerations(bodies, bx.data(), by.data());
+    }
+    EXPECT_EQ(probed.getStats().evaluations, 10U);
+    EXPECT_EQ(probed.getStats().refreshes, 1U);
+    EXPECT_EQ(probed.getStats().pairs, plain.getStats().pairs);
+    EXPECT_EQ(probed.getStats().neglectedSum, plain.getStats().neglectedSum);
+    EXPECT_EQ(ax, bx);
+    EXPECT_EQ(ay, by);
+}
+
+TEST_F(PrunedSolverTest, PrunesSunDominatedBelt)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(1000);
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    auto pruned = std::make_unique<PrunedSolver>(1e-6, 16);
+    pruned->setValidation(true);
+    univ->setForceSolver(std::move(pruned));
+
+    univ->stepSimulation(3600);
+    const auto& solver = dynamic_cast<const PrunedSolver&>(univ->getForceSolver());
+    const PrunedStats& stats = solver.getStats();
+    // Right after a rebuild the error is within the reported bound
+    const double bound = stats.neglectedRelative;
+    EXPECT_GT(bound, 0.0);
+    EXPECT_LT(bound, 1e-4);
+    EXPECT_LE(univ->getForceSolver().getLastError().maxRelative, bound);
+
+    double worst = 0.0;
+    for (int i = 0; i < 47; ++i) {
+        univ->stepSimulation(3600);
+        worst = std::max(worst, univ->getForceSolver().getLastError().maxRelative);
+    }
+    EXPECT_EQ(stats.evaluations, 49U);
+    EXPECT_EQ(stats.refreshes, 4U);
+    EXPECT_GT(solver.getReduction(), 0.8);
+    EXPECT_LT(worst, 1e-4);
+    EXPECT_GT(stats.neglectedSum, 0.0);
+}
+
+TEST_F(PrunedSolverTest, RejectsInvalidConfiguration)
+{
+    EXPECT_THROW(PrunedSolver(-1e-6), std::logic_error);
+    EXPECT_THROW(PrunedSolver(1e-6, 0), std::logic_error);
+    PrunedSolver solver;
+    EXPECT_EQ(solver.getThreshold(), 1e-6);
+    EXPECT_EQ(solver.getInterval(), 16U);
+    EXPECT_EQ(solver.getReduction(), 0.0);
+}
@@ -0,0 +1,83 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "integrators/leapfrog.h"
+#include "parser.h"
+#include "solvers/barnes_hut.h"
+#include "solvers/direct_solver.h"
+#include "solvers/fmm.h"
+#include "solvers/simd_solver.h"
+#include "universe.h"
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+// The fixture for testing the thread independent reductions.
+class ReproducibleTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Steps the solar system with a belt on the given number of threads and
+ * returns every coordinate at the end
+ * @param make - creates the force solver to step with
+ * @param threads - number of threads of the Universe
+ * @param deterministic - true to sum independently of the threads
+ */
+std::vector<double> run(const std::function<std::unique_ptr<ForceSolver>()>& make,
+    std::size_t threads, bool deterministic = true)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    makeAsteroidBelt(301);
+    univ->setDeterministic(deterministic);
+    univ->setForceSolver(make());
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    univ->setThreadCount(threads);
+    for (int i = 0; i < 20; ++i)
+        univ->stepSimulation(86400);
+
+    const BodyStore& bodies = univ->getBodies();
+    std::vector<double> state(bodies.x(), bodies.x() + bodies.size());
+    state.insert(state.end(), bodies.y(), bodies.y() + bodies.size());
+    return state;
+}
+
+} // anonymous namespace
+
+TEST_F(ReproducibleTest, SameBitsForAnyThreadCount)
+{
+    const std::vector<std::function<std::unique_ptr<ForceSolver>()>> solvers {
+        [] { return std::make_unique<DirectSolver>(); },
+        [] { return std::make_unique<SimdSolver>(); },
+        [] {
+            auto solver = std::make_unique<SimdSolver>();
+            solver->setPrecision(SimdPrecision::Mixed);
+            return solver;
+        },
+        [] { return std::make_unique<BarnesHutSolver>(); },
+        [] { return std::make_unique<FmmSolver>(); },
+    };
+    for (const auto& make : solvers) {
+        const std::vector<double> serial = run(make, 1);
+        for (std::size_t threads : { 2, 3, 4 })
+            EXPECT_EQ(run(make, threads), serial);
+    }
+}
+
+TEST_F(ReproducibleTest, FastModeKeepsPairSymmetry)
+{
+    const auto make = [] { return std::make_unique<DirectSolver>(); };
+    // The serial pair loop rounds differently from the rows
+    const std::vector<double> fast = run(make, 1, false);
+    EXPECT_NE(fast, run(make, 1));
+    EXPECT_EQ(run(make, 2, false), run(make, 1));
+
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    EXPECT_FALSE(univ->getDeterministic());
+    univ->setDeterministic(true);
+    EXPECT_TRUE(univ->getForceSolver().getDeterministic());
+    univ->setForceSolver(std::make_unique<BarnesHutSolver>());
+    EXPECT_TRUE(univ->getForceSolver().getDeterministic());
+}
@@ -0,0 +1,147 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "solvers/direct_solver.h"
+#include "solvers/simd_solver.h"
+#include "universe.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+// The fixture for testing the vectorized all-pairs force solver.
+class SimdSolverTest : public ::testing::Test { };
+
+TEST_F(SimdSolverTest, EveryLevelMatchesDirectSum)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeEarth();
+    ObjectFactory::makeJupiter();
+    // Enough bodies for several source tiles and a ragged tail of targets
+    makeAsteroidBelt(4500);
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        SimdSolver solver;
+        solver.setLevel(level);
+        const ForceError error = solver.validate(univ->getBodies());
+        EXPECT_LT(error.maxRelative, SimdSolver::SIMD_TOLERANCE);
+    }
+}
+
+TEST_F(SimdSolverTest, CoincidentAndDistantBodies)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeStar("far-sun", 1e30);
+    // Three stacks of three coincident planets, far enough out to overflow a float
+    for (int i = 0; i < 9; ++i) {
+        const double y = 1e9 * (i % 3) * (i % 3);
+        ObjectFactory::makePlanet("p", 1e24, makeVector2(1e20, y), makeVector2(0, 0));
+    }
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        SimdSolver solver;
+        solver.setLevel(level);
+        const ForceError error = solver.validate(univ->getBodies());
+        EXPECT_LT(error.maxRelative, SimdSolver::SIMD_TOLERANCE);
+    }
+}
+
+TEST_F(SimdSolverTest, LevelIsClampedToCpu)
+{
+    SimdSolver solver;
+    EXPECT_EQ(solver.getLevel(), SimdSolver::detect());
+    solver.setLevel(SimdLevel::Avx512);
+    EXPECT_EQ(solver.getLevel(), SimdSolver::detect());
+    solver.setLevel(SimdLevel::Scalar);
+    EXPECT_EQ(solver.getLevel(), SimdLevel::Scalar);
+}
+
+TEST_F(SimdSolverTest, SelectableOnUniverse)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    const Object* earth = ObjectFactory::makeEarth();
+    makeAsteroidBelt(100);
+
+    auto solver = std::make_unique<SimdSolver>();
+    solver->setValidation(true);
+    univ->setForceSolver(std::move(solver));
+    const Vector2 start = earth->getPosition();
+    for (int i = 0; i < 24; ++i)
+        univ->stepSimulation(3600);
+
+    EXPECT_NE(earth->getPosition(), start);
+    EXPECT_LT(univ->getForceSolver().getLastError().maxRelative, SimdSolver::SIMD_TOLERANCE);
+}
+
+TEST_F(SimdSolverTest, MixedPrecisionMatchesObjectForces)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    const Object* earth = ObjectFactory::makeEarth();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(4500);
+    const BodyStore& bodies = univ->getBodies();
+
+    // The pull on the earth summed pair by pair through the objects
+    Vector2 force;
+    for (const Object* other : *univ)
+        force += earth->getForce(*other);
+    const Vector2 expected = force / earth->getMass();
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        SimdSolver solver;
+        solver.setLevel(level);
+        solver.setPrecision(SimdPrecision::Mixed);
+        EXPECT_EQ(solver.getPrecision(), SimdPrecision::Mixed);
+        const ForceError error = solver.validate(bodies);
+        EXPECT_LT(error.maxRelative, SimdSolver::MIXED_TOLERANCE);
+        // Far from double precision, so the pairs really are computed in float
+        EXPECT_GT(error.rmsRelative, SimdSolver::SIMD_TOLERANCE);
+
+        std::vector<double> ax(bodies.size());
+        std::vector<double> ay(bodies.size());
+        solver.computeAccelerations(bodies, ax.data(), ay.data());
+        const Vector2 got = makeVector2(ax[1], ay[1]);
+        assertVector(got, expected, SimdSolver::MIXED_TOLERANCE * expected.norm());
+    }
+}
+
+TEST_F(SimdSolverTest, MixedPrecisionResolvesClosePairsFarOut)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    // A binary 300 m apart at 30 AU, closer than a float resolves its distance from the sun
+    ObjectFactory::makePlanet("a", 1e22, makeVector2(4.5e12, 0), makeVector2(0, 0));
+    ObjectFactory::makePlanet("b", 1e22, makeVector2(4.5e12 + 300, 100), makeVector2(0, 0));
+    makeAsteroidBelt(40);
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        SimdSolver solver;
+        solver.setLevel(level);
+        solver.setPrecision(SimdPrecision::Mixed);
+        const ForceError error = solver.validate(univ->getBodies());
+        EXPECT_LT(error.maxRelative, SimdSolver::MIXED_TOLERANCE);
+    }
+}
+
+TEST_F(SimdSolverTest, MixedPrecisionKeepsRange)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeStar("far-sun", 1e30);
+    // Offsets whose cube overflows a float unless scaled
+    for (int i = 0; i < 9; ++i) {
+        const double y = 1e9 * (i % 3) * (i % 3);
+        ObjectFactory::makePlanet("p", 1e24, makeVector2(1e20, y), makeVector2(0, 0));
+    }
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        SimdSolver solver;
+        solver.setLevel(level);
+        solver.setPrecision(SimdPrecision::Mixed);
+        const ForceError error = solver.validate(univ->getBodies());
+        EXPECT_LT(error.maxRelative, SimdSolver::MIXED_TOLERANCE);
+    }
+}
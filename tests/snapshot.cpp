@@ -0,0 +1,129 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "body_store.h"
+#include "integrators/leapfrog.h"
+#include "objects/object.h"
+#include "parser.h"
+#include "universe.h"
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> allocations = 0; // Calls to the global operator new so far
+
+} // anonymous namespace
+
+// Counts every heap allocation of the test binary
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+// The fixture for testing the double-buffered snapshots.
+class SnapshotTest : public ::testing::Test { };
+
+TEST_F(SnapshotTest, ViewsStayFrozen)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    const Object* earth = *(univ->begin() + 3);
+    const Vector2 start = earth->getPosition();
+
+    const BodyStore& first = univ->snapshot();
+    univ->stepSimulation(3600);
+    const BodyStore& second = univ->snapshot();
+    univ->stepSimulation(3600);
+
+    // Both views hold the state they were taken at
+    EXPECT_NE(&first, &second);
+    EXPECT_NE(&second, &univ->getBodies());
+    EXPECT_EQ(first.getPosition(3), start);
+    EXPECT_NE(second.getPosition(3), start);
+    EXPECT_NE(earth->getPosition(), second.getPosition(3));
+    EXPECT_EQ(first.size(), univ->getBodies().size());
+
+    // The third snapshot overwrites the first buffer
+    const BodyStore& third = univ->snapshot();
+    EXPECT_EQ(&third, &first);
+    EXPECT_EQ(third.getPosition(3), earth->getPosition());
+}
+
+TEST_F(SnapshotTest, RestoreRewinds)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    univ->stepSimulation(3600);
+    const BodyStore& saved = univ->snapshot();
+    const std::uint64_t version = univ->getBodies().getVersion();
+    std::vector<Vector2> expected;
+    for (int i = 0; i < 10; ++i) {
+        univ->stepSimulation(3600);
+        expected.push_back(univ->getBodies().getPosition(5));
+    }
+
+    // Stepping on from the restored state repeats the same steps
+    EXPECT_EQ(univ->getTime(), 3600.0 * 11);
+    univ->restore(saved);
+    EXPECT_NE(univ->getBodies().getVersion(), version);
+    EXPECT_EQ(univ->getTime(), 3600.0);
+    for (int i = 0; i < 10; ++i) {
+        univ->stepSimulation(3600);
+        EXPECT_EQ((*(univ->begin() + 5))->getPosition(), expected[i]);
+    }
+    EXPECT_EQ(univ->getTime(), 3600.0 * 11);
+
+    BodyStore wrong;
+    wrong.add(1.0, makeVector2(), makeVector2());
+    EXPECT_THROW(univ->restore(wrong), std::logic_error);
+}
+
+TEST_F(SnapshotTest, NoAllocationsInSteadyState)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    makeAsteroidBelt(1000);
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+
+    // Both buffers and the accelerations are sized by the first steps
+    for (int i = 0; i < 2; ++i) {
+        univ->stepSimulation(3600);
+        [[maybe_unused]] const BodyStore& state = univ->snapshot();
+    }
+
+    const std::size_t before = allocations;
+    double sum = 0.0;
+    for (int i = 0; i < 100; ++i) {
+        univ->stepSimulation(3600);
+        sum += univ->snapshot().getPosition(3)[0];
+    }
+    univ->restore(univ->snapshot());
+    EXPECT_EQ(allocations - before, 0U);
+    EXPECT_NE(sum, 0.0);
+
+    // Cloning the objects allocates for every one of them
+    std::vector<Object*> clones = univ->getSnapshot();
+    EXPECT_GT(allocations - before, clones.size());
+    for (Object* clone : clones)
+        delete clone;
+}
@@ -0,0 +1,88 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "body_store.h"
+#include "integrators/euler.h"
+#include "integrators/leapfrog.h"
+#include "integrators/yoshida.h"
+#include "parser.h"
+#include "solvers/direct_solver.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+// The fixture for testing the spatial body store, solver and integrators.
+class SpatialTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Returns the total angular momentum about the sun of the bodies that pull
+ * @param bodies - state to measure
+ */
+Vector3 angularMomentum(const BodyStore3& bodies)
+{
+    Vector3 total;
+    for (const std::uint32_t slot : bodies.getSources())
+        total += bodies.getMass(slot) * (bodies.getPosition(slot) ^ bodies.getVelocity(slot));
+    return total;
+}
+
+} // anonymous namespace
+
+TEST_F(SpatialTest, PlanarSceneMatchesPlanarRun)
+{
+    BodyStore planar;
+    BodyStore3 spatial;
+    Parser::loadBodies("../tests/solar_system.json", planar);
+    Parser::loadBodies("../tests/solar_system.json", spatial);
+    ASSERT_EQ(spatial.size(), planar.size());
+
+    // The z terms are all zero, so the planar arithmetic is repeated exactly
+    DirectSolver solver;
+    DirectSolver3 solver3;
+    LeapfrogIntegrator leapfrog;
+    LeapfrogIntegrator3 leapfrog3;
+    leapfrog.advance(planar, solver, 3600, 500);
+    leapfrog3.advance(spatial, solver3, 3600, 500);
+    EulerIntegrator euler;
+    EulerIntegrator3 euler3;
+    euler.advance(planar, solver, 3600, 500);
+    euler3.advance(spatial, solver3, 3600, 500);
+    for (std::size_t slot = 0; slot < planar.size(); ++slot) {
+        EXPECT_EQ(spatial.x()[slot], planar.x()[slot]);
+        EXPECT_EQ(spatial.y()[slot], planar.y()[slot]);
+        EXPECT_EQ(spatial.z()[slot], 0.0);
+        EXPECT_EQ(spatial.vz()[slot], 0.0);
+    }
+}
+
+TEST_F(SpatialTest, InclinedOrbitsKeepTheirPlane)
+{
+    BodyStore3 bodies;
+    Parser::loadBodies("../tests/inclined_system.json", bodies);
+    ASSERT_EQ(bodies.size(), 5U);
+    EXPECT_TRUE(bodies.isParticle(4));
+    const Vector3 momentum = angularMomentum(bodies);
+
+    // Ten years of daily steps
+    DirectSolver3 solver;
+    YoshidaIntegrator3 integrator(4);
+    integrator.advance(bodies, solver, 86400, 3650);
+
+    // Central and pairwise pulls exert no net torque about the fixed sun
+    const Vector3 after = angularMomentum(bodies);
+    EXPECT_LT((after - momentum).norm(), 1e-10 * momentum.norm());
+
+    // Pluto and the comet have left the ecliptic, Earth is still in it
+    EXPECT_GT(std::abs(bodies.z()[3]), 1e11);
+    EXPECT_GT(std::abs(bodies.vz()[4]), 1e3);
+    EXPECT_LT(std::abs(bodies.z()[1]), 1e9);
+    EXPECT_EQ(bodies.getPosition(0), Vector3());
+}
+
+TEST_F(SpatialTest, ScenesMustFitTheDimension)
+{
+    BodyStore planar;
+    EXPECT_THROW(Parser::loadBodies("../tests/inclined_system.json", planar), std::logic_error);
+    EXPECT_THROW(Parser::loadBodies("../tests/missing.json", planar), std::logic_error);
+}
@@ -2,9 +2,14 @@
 #ifndef TESTHELPER_H
 #define TESTHELPER_H
 
+#include "objects/object_factory.h"
+#include "universe.h"
 #include "vector.h"
+#include <cmath>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <random>
+#include <string>
 
 /**
  *  Given a test vector and a correct vector, this function will check if the
@@ -63,4 +68,27 @@ inline Vector2 getNextVector(std::ifstream& file)
     return v;
 }
 
+/**
+ *  Adds count asteroids on circular orbits between 3e11 and 5e11 meters around
+ *  a sun that must already be registered as the first object.
+ *  @param count - number of asteroids to create
+ *  @param seed - seed of the random number generator
+ */
+inline void makeAsteroidBelt(const std::size_t count, const unsigned seed = 42)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> radius(3e11, 5e11);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<double> logMass(15.0, 20.0);
+    const double mu = Universe::G * 1.98892e30;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double r = radius(rng);
+        const double phi = angle(rng);
+        const double speed = std::sqrt(mu / r);
+        ObjectFactory::makeAsteroid("belt-" + std::to_string(i), std::pow(10.0, logMass(rng)),
+            makeVector2(r * std::cos(phi), r * std::sin(phi)),
+            makeVector2(-speed * std::sin(phi), speed * std::cos(phi)));
+    }
+}
+
 #endif // TESTHELPER_H
@@ -0,0 +1,195 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "body_store.h"
+#include "integrators/leapfrog.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "parser.h"
+#include "solvers/barnes_hut.h"
+#include "solvers/direct_solver.h"
+#include "solvers/fmm.h"
+#include "solvers/simd_solver.h"
+#include "universe.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// The fixture for testing massless test particles.
+class TestParticlesTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Runs the planets of solar_system.json for a year of daily leapfrog steps and
+ * returns the final positions of the planets
+ * @param belt - number of asteroids to add, flagged as test particles
+ */
+std::vector<Vector2> runPlanets(std::size_t belt)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    const std::size_t planets = univ->getBodies().size();
+    makeAsteroidBelt(belt);
+    univ->setParticleThreshold(1e21);
+    univ->setIntegrator(std::make_unique<LeapfrogIntegrator>());
+    for (int day = 0; day < 365; ++day)
+        univ->stepSimulation(86400);
+
+    std::vector<Vector2> positions;
+    for (std::size_t slot = 0; slot < planets; ++slot)
+        positions.push_back(univ->getBodies().getPosition(slot));
+    return positions;
+}
+
+} // anonymous namespace
+
+TEST_F(TestParticlesTest, PlanetsIgnoreParticles)
+{
+    const std::vector<Vector2> alone = runPlanets(0);
+    const std::vector<Vector2> crowded = runPlanets(500);
+    // The sources are the same bodies in the same order, so the sums are too
+    ASSERT_EQ(crowded.size(), alone.size());
+    for (std::size_t slot = 0; slot < alone.size(); ++slot)
+        EXPECT_EQ(crowded[slot], alone[slot]);
+}
+
+TEST_F(TestParticlesTest, ParticlesFeelTheSources)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    Object* asteroid
+        = ObjectFactory::makeAsteroid("ceres", 9e20, makeVector2(4e11, 1e11), makeVector2());
+    const BodyStore& bodies = univ->getBodies();
+    DirectSolver solver;
+    std::vector<double> ax(3);
+    std::vector<double> ay(3);
+    solver.computeAccelerations(bodies, ax.data(), ay.data());
+    const double regularX = ax[2];
+    const double regularY = ay[2];
+    const double jupiterX = ax[1];
+
+    // The asteroid's own mass never entered its acceleration, only Jupiter's
+    asteroid->setTestParticle(true);
+    EXPECT_TRUE(bodies.isParticle(2));
+    solver.computeAccelerations(bodies, ax.data(), ay.data());
+    EXPECT_DOUBLE_EQ(ax[2], regularX);
+    EXPECT_DOUBLE_EQ(ay[2], regularY);
+    EXPECT_NE(ax[1], jupiterX);
+}
+
+TEST_F(TestParticlesTest, EverySolverAgrees)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    makeAsteroidBelt(3000);
+    univ->setParticleThreshold(1e21);
+    const BodyStore& bodies = univ->getBodies();
+    EXPECT_EQ(bodies.getSources().size(), 9U);
+
+    DirectSolver direct;
+    EXPECT_LT(direct.validate(bodies).maxRelative, 1e-15);
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+        SimdSolver simd;
+        simd.setLevel(level);
+        EXPECT_LT(simd.validate(bodies).maxRelative, SimdSolver::SIMD_TOLERANCE);
+    }
+    BarnesHutSolver barnesHut(0.5);
+    EXPECT_LT(barnesHut.validate(bodies).maxRelative, 1e-3);
+    FmmSolver fmm(10);
+    EXPECT_LT(fmm.validate(bodies).maxRelative, 1e-3);
+
+    // Parallel rows only run over the sources as well
+    univ->setThreadCount(4);
+    direct.setThreadPool(univ->getThreadPool());
+    EXPECT_LT(direct.validate(bodies).maxRelative, 1e-14);
+}
+
+TEST_F(TestParticlesTest, ThresholdReclassifies)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    const Object* earth = ObjectFactory::makeEarth();
+    Object* asteroid
+        = ObjectFactory::makeAsteroid("rock", 1e18, makeVector2(3e11, 0), makeVector2(0, 2e4));
+    const BodyStore& bodies = univ->getBodies();
+    EXPECT_EQ(univ->getParticleThreshold(), 0.0);
+    EXPECT_EQ(bodies.getSources().size(), 3U);
+
+    univ->setParticleThreshold(1e21);
+    EXPECT_FALSE(bodies.isParticle(0));
+    EXPECT_FALSE(earth->isTestParticle());
+    EXPECT_TRUE(asteroid->isTestParticle());
+    EXPECT_EQ(bodies.getSources(), (std::vector<std::uint32_t> { 0, 1 }));
+
+    // Later bodies are classified on registration, flags are kept in snapshots
+    ObjectFactory::makeAsteroid("pebble", 1e10, makeVector2(4e11, 0), makeVector2(0, 2e4));
+    EXPECT_TRUE(bodies.isParticle(3));
+    asteroid->setTestParticle(false);
+    EXPECT_EQ(bodies.getSources(), (std::vector<std::uint32_t> { 0, 1, 2 }));
+    std::vector<Object*> snapshot = univ->getSnapshot();
+    EXPECT_FALSE(snapshot[2]->isTestParticle());
+    EXPECT_TRUE(snapshot[3]->isTestParticle());
+    univ->swap(snapshot);
+    EXPECT_EQ(univ->getBodies().getSources(), (std::vector<std::uint32_t> { 0, 1, 2 }));
+
+    // Even a sun below the threshold still pulls
+    univ->setParticleThreshold(1e31);
+    EXPECT_EQ(univ->getBodies().getSources(), (std::vector<std::uint32_t> { 0 }));
+    univ->setParticleThreshold(0.0);
+    EXPECT_EQ(univ->getBodies().getSources().size(), 4U);
+    EXPECT_THROW(univ->setParticleThreshold(-1.0), std::logic_error);
+}
+
+TEST_F(TestParticlesTest, SunNeverBecomesParticle)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Star* sun = ObjectFactory::makeSun();
+    ObjectFactory::makeEarth();
+    EXPECT_THROW(sun->setTestParticle(true), std::logic_error);
+    BodyStore store;
+    EXPECT_THROW(store.add(1.0, makeVector2(0, 0), makeVector2(0, 0), true), std::logic_error);
+    store.add(1.0, makeVector2(0, 0), makeVector2(0, 0));
+    EXPECT_THROW(store.setParticle(0, true), std::logic_error);
+    EXPECT_FALSE(sun->isTestParticle());
+    EXPECT_EQ(univ->getBodies().activeMass()[0], sun->getMass());
+
+    // A snapshot flagging the sun is swapped in with the sun still pulling
+    std::vector<Object*> snapshot = univ->getSnapshot();
+    snapshot[0]->setTestParticle(true);
+    univ->swap(snapshot);
+    EXPECT_FALSE(univ->getBodies().isParticle(0));
+    EXPECT_EQ(univ->getBodies().getSources(), (std::vector<std::uint32_t> { 0, 1 }));
+}
+
+TEST_F(TestParticlesTest, ParserFlagsParticles)
+{
+    const std::string path = "particles_test.json";
+    {
+        std::ofstream config(path);
+        config << R"([
+            {"name": "sun", "mass": 1.98892e30},
+            {"name": "earth", "mass": 5.9742e24, "pos": [1.5e11, 0], "vel": [0, 29788]},
+            {"name": "moonlet", "mass": 1e22, "pos": [2e11, 0], "vel": [0, 25000],
+                "particle": true},
+            {"name": "halley", "mass": 2.2e14, "pos": [8.8e10, 0], "vel": [0, 54550],
+                "comp": "ice", "particle": true},
+            {"name": "rock", "mass": 1e18, "pos": [3e11, 0], "vel": [0, 20000],
+                "particle": false}
+        ])";
+    }
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile(path);
+    std::remove(path.c_str());
+
+    const BodyStore& bodies = univ->getBodies();
+    ASSERT_EQ(bodies.size(), 5U);
+    EXPECT_EQ(bodies.getSources(), (std::vector<std::uint32_t> { 0, 1, 4 }));
+    EXPECT_EQ(bodies.activeMass()[2], 0.0);
+    EXPECT_EQ(bodies.getMass(2), 1e22);
+}
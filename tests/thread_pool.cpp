@@ -0,0 +1,231 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "objects/object_factory.h"
+#include "solvers/barnes_hut.h"
+#include "solvers/direct_solver.h"
+#include "solvers/fmm.h"
+#include "solvers/simd_solver.h"
+#include "thread_pool.h"
+#include "universe.h"
+#include "visitors/visitor.h"
+#include <atomic>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+
+// The fixture for testing the work-stealing pool and the parallel step.
+class ThreadPoolTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Steps a fresh belt a few times and returns the final positions
+ */
+std::vector<double> runBelt(std::size_t threads, std::unique_ptr<ForceSolver> solver)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(1000);
+    univ->setThreadCount(threads);
+    if (solver)
+        univ->setForceSolver(std::move(solver));
+    for (int i = 0; i < 10; ++i)
+        univ->stepSimulation(3600);
+
+    const BodyStore& bodies = univ->getBodies();
+    std::vector<double> state(bodies.x(), bodies.x() + bodies.size());
+    state.insert(state.end(), bodies.y(), bodies.y() + bodies.size());
+    return state;
+}
+
+/**
+ * Visitor counting the objects of every kind, safe to call concurrently
+ */
+class CountingVisitor : public Visitor {
+public:
+    void visit(const Planet&) const override
+    {
+        ++planets;
+    }
+    void visit(const Star&) const override
+    {
+        ++stars;
+    }
+    void visit(const Asteroid&) const override
+    {
+        ++asteroids;
+    }
+    void visit(const Comet&) const override
+    {
+        ++comets;
+    }
+
+    mutable std::atomic<int> planets = 0; // Planets visited
+    mutable std::atomic<int> stars = 0; // Stars visited
+    mutable std::atomic<int> asteroids = 0; // Asteroids visited
+    mutable std::atomic<int> comets = 0; // Comets visited
+};
+
+} // anonymous namespace
+
+TEST_F(ThreadPoolTest, CoversRangeInAlignedChunks)
+{
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.getWorkerCount(), 4u);
+    for (std::size_t count : { 0, 1, 7, 8, 9, 100, 1001, 20000 }) {
+        std::vector<std::atomic<int>> hits(count);
+        pool.parallelFor(count, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+            EXPECT_LT(worker, 4u);
+            EXPECT_LE(begin, end);
+            EXPECT_EQ(begin % ThreadPool::CHUNK_ALIGN, 0u);
+            for (std::size_t i = begin; i < end; ++i)
+                ++hits[i];
+        });
+        for (const auto& hit : hits)
+            EXPECT_EQ(hit, 1);
+    }
+}
+
+TEST_F(ThreadPoolTest, RecursiveTasksAndCounters)
+{
+    ThreadPool pool(4);
+    std::atomic<std::uint64_t> sum = 0;
+    std::atomic<std::uint64_t> spawned = 0;
+    {
+        // Sum 0 .. 2^14 - 1 by splitting the range down to single numbers
+        ThreadPool::TaskGroup group(pool);
+        std::function<void(std::uint64_t, std::uint64_t)> split
+            = [&](std::uint64_t begin, std::uint64_t end) {
+                  ++spawned;
+                  if (end - begin == 1) {
+                      sum += begin;
+                      return;
+                  }
+                  const std::uint64_t mid = (begin + end) / 2;
+                  group.run([&split, begin, mid] { split(begin, mid); });
+                  group.run([&split, mid, end] { split(mid, end); });
+              };
+        group.run([&split] { split(0, 1 << 14); });
+        group.wait();
+    }
+    EXPECT_EQ(sum, (1u << 14) * ((1u << 14) - 1) / 2);
+
+    const std::vector<ThreadPool::WorkerStats> stats = pool.getStats();
+    ASSERT_EQ(stats.size(), 4u);
+    std::uint64_t tasks = 0;
+    for (const auto& worker : stats) {
+        EXPECT_LE(worker.steals, worker.tasks);
+        EXPECT_GE(worker.busySeconds, 0.0);
+        tasks += worker.tasks;
+    }
+    EXPECT_EQ(tasks, spawned);
+
+    pool.resetStats();
+    for (const auto& worker : pool.getStats()) {
+        EXPECT_EQ(worker.tasks, 0u);
+        EXPECT_EQ(worker.steals, 0u);
+        EXPECT_EQ(worker.busySeconds, 0.0);
+    }
+}
+
+TEST_F(ThreadPoolTest, RethrowsWorkerExceptions)
+{
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.parallelFor(100,
+                     [](std::size_t begin, std::size_t, std::size_t) {
+                         if (begin == 0)
+                             throw std::runtime_error("chunk failed");
+                     }),
+        std::runtime_error);
+    // The pool is still usable afterwards
+    std::atomic<std::size_t> covered = 0;
+    pool.parallelFor(
+        10, [&](std::size_t begin, std::size_t end, std::size_t) { covered += end - begin; });
+    EXPECT_EQ(covered, 10u);
+    EXPECT_THROW(ThreadPool(0), std::logic_error);
+}
+
+TEST_F(ThreadPoolTest, OneThreadIsIdenticalToSerial)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeJupiter();
+    makeAsteroidBelt(500);
+    EXPECT_EQ(univ->getThreadCount(), 1u);
+    EXPECT_THROW(univ->setThreadCount(0), std::logic_error);
+
+    const BodyStore& bodies = univ->getBodies();
+    std::vector<double> serialX(bodies.size());
+    std::vector<double> serialY(bodies.size());
+    std::vector<double> pooledX(bodies.size());
+    std::vector<double> pooledY(bodies.size());
+    ThreadPool single(1);
+    for (int kind = 0; kind < 3; ++kind) {
+        std::unique_ptr<ForceSolver> solver;
+        if (kind == 0)
+            solver = std::make_unique<DirectSolver>();
+        else if (kind == 1)
+            solver = std::make_unique<SimdSolver>();
+        else
+            solver = std::make_unique<BarnesHutSolver>(0.5);
+        solver->computeAccelerations(bodies, serialX.data(), serialY.data());
+        solver->setThreadPool(&single);
+        solver->computeAccelerations(bodies, pooledX.data(), pooledY.data());
+        EXPECT_EQ(pooledX, serialX);
+        EXPECT_EQ(pooledY, serialY);
+    }
+}
+
+TEST_F(ThreadPoolTest, ParallelStepMatchesSerial)
+{
+    const std::vector<double> serial = runBelt(1, nullptr);
+    const std::vector<double> direct = runBelt(8, nullptr);
+    const std::vector<double> simd = runBelt(8, std::make_unique<SimdSolver>());
+    ASSERT_EQ(serial.size(), direct.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_NEAR(direct[i], serial[i], 1e-9 * std::abs(serial[i]));
+        EXPECT_NEAR(simd[i], serial[i], 1e-9 * std::abs(serial[i]));
+    }
+}
+
+TEST_F(ThreadPoolTest, ParallelBarnesHutMatchesSerial)
+{
+    const std::vector<double> serial = runBelt(1, std::make_unique<BarnesHutSolver>(0.5));
+    const std::vector<double> parallel = runBelt(6, std::make_unique<BarnesHutSolver>(0.5));
+    // Every walk is independent, so the results are bit for bit the same
+    EXPECT_EQ(parallel, serial);
+}
+
+TEST_F(ThreadPoolTest, ParallelVisitorTraversal)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    ObjectFactory::makeSun();
+    ObjectFactory::makeEarth();
+    ObjectFactory::makeHalley();
+    makeAsteroidBelt(3000);
+    univ->setThreadCount(4);
+    univ->getThreadPool()->resetStats();
+
+    CountingVisitor visitor;
+    univ->accept(visitor, true);
+    EXPECT_EQ(visitor.stars, 1);
+    EXPECT_EQ(visitor.planets, 1);
+    EXPECT_EQ(visitor.comets, 1);
+    EXPECT_EQ(visitor.asteroids, 3000);
+
+    // Many small tasks were handed out for the traversal
+    std::uint64_t tasks = 0;
+    for (const auto& worker : univ->getThreadPool()->getStats())
+        tasks += worker.tasks;
+    EXPECT_GT(tasks, 10u);
+}
+
+TEST_F(ThreadPoolTest, ParallelFmmMatchesSerial)
+{
+    const std::vector<double> serial = runBelt(1, std::make_unique<FmmSolver>(8));
+    const std::vector<double> parallel = runBelt(5, std::make_unique<FmmSolver>(8));
+    EXPECT_EQ(parallel, serial);
+}
@@ -0,0 +1,75 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "vector.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <type_traits>
+
+// The fixture for testing the vector expression templates.
+class VectorExprTest : public ::testing::Test { };
+
+// Expressions add no storage to a vector and keep it trivially copyable
+static_assert(sizeof(Vector2) == 2 * sizeof(double));
+static_assert(std::is_trivially_copyable_v<Vector2>);
+static_assert(!std::is_convertible_v<const double*, Vector2>);
+
+TEST_F(VectorExprTest, MatchesComponentArithmetic)
+{
+    const Vector2 pos = makeVector2(1.5e11, -2.25e10);
+    const Vector2 vel = makeVector2(-3.1e3, 2.9e4);
+    const double dt = 3600.0;
+
+    // The operators build nodes, a vector is only produced on assignment
+    static_assert(!std::is_same_v<decltype(pos + dt * vel), Vector2>);
+    const Vector2 moved = pos + dt * vel;
+    EXPECT_EQ(moved[0], pos[0] + vel[0] * dt);
+    EXPECT_EQ(moved[1], pos[1] + vel[1] * dt);
+
+    const double dx = moved[0] - pos[0];
+    const double dy = moved[1] - pos[1];
+    EXPECT_EQ((moved - pos).normSq(), dx * dx + dy * dy);
+    EXPECT_EQ((moved - pos).norm(), std::sqrt(dx * dx + dy * dy));
+    EXPECT_EQ((moved - pos) * vel, dx * vel[0] + dy * vel[1]);
+    EXPECT_EQ(pos.dot(moved - pos), pos[0] * dx + pos[1] * dy);
+    EXPECT_EQ((moved - pos) / dt, vel);
+    EXPECT_EQ(-(pos - moved), moved - pos);
+    EXPECT_EQ((moved - pos).normalize(), vel.normalize());
+    EXPECT_EQ((-pos).toString(), pos.invert().toString());
+    EXPECT_THROW((pos - pos).normalize(), std::overflow_error);
+}
+
+TEST_F(VectorExprTest, CompoundAssignment)
+{
+    Vector2 pos = makeVector2(1.0, 2.0);
+    const Vector2 vel = makeVector2(0.5, -0.25);
+
+    pos += 4.0 * vel;
+    EXPECT_EQ(pos, makeVector2(3.0, 1.0));
+    pos -= vel - pos;
+    EXPECT_EQ(pos, makeVector2(5.5, 2.25));
+    pos *= 2.0;
+    pos /= 4.0;
+    EXPECT_EQ(pos, makeVector2(2.75, 1.125));
+
+    // Every component is read before it is overwritten
+    pos = vel - pos;
+    EXPECT_EQ(pos, makeVector2(-2.25, -1.375));
+    pos = pos + pos;
+    EXPECT_EQ(pos, makeVector2(-4.5, -2.75));
+}
+
+TEST_F(VectorExprTest, TemporariesAreHeldByValue)
+{
+    const Vector2 vel = makeVector2(1.0, 2.0);
+
+    // The operands made on this line are gone before the expression is read
+    const auto sum = makeVector2(3.0, 4.0) + 2.0 * makeVector2(0.5, 0.5) - vel;
+    EXPECT_EQ(Vector2(sum), makeVector2(3.0, 3.0));
+
+    const double basis[] = { 1, 0, 0, 1, 0, 0, -2 };
+    const Vector3 x(basis);
+    const Vector3 y(basis + 2);
+    EXPECT_EQ((x + y) ^ (x - y), Vector3(basis + 4));
+    EXPECT_THROW(Vector2(vel) ^ vel, std::domain_error);
+}
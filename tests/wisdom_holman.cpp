@@ -0,0 +1,154 @@
+// Name: Chengtong Zhu; vunetid: zhuc13; email address: chengtong.zhu@vanderbil.edu; honor code: I
+// pledge on my honor that I have neither given nor received unauthorized aid on this assignment.
+#include "./test_helper.h"
+#include "integrators/dormand_prince.h"
+#include "integrators/kepler.h"
+#include "integrators/leapfrog.h"
+#include "integrators/wisdom_holman.h"
+#include "objects/object_factory.h"
+#include "objects/planet.h"
+#include "objects/star.h"
+#include "parser.h"
+#include "universe.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+// The fixture for testing the Wisdom-Holman map and its Kepler drift.
+class WisdomHolmanTest : public ::testing::Test { };
+
+namespace {
+
+/**
+ * Runs the planets of solar_system.json for five years and returns the final
+ * positions
+ * @param integrator - scheme to step with
+ * @param dt - requested time step, rounded so the run spans five years in at
+ * least one step
+ * @param threads - number of threads of the universe
+ */
+std::vector<Vector2> runPlanets(
+    std::unique_ptr<Integrator> integrator, double dt, std::size_t threads = 1)
+{
+    const double total = 5 * 31557600.0;
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    Parser::loadFile("../tests/solar_system.json");
+    univ->setThreadCount(threads);
+    univ->setIntegrator(std::move(integrator));
+    const long steps = std::max(1L, std::lround(total / dt));
+    for (long i = 0; i < steps; ++i)
+        univ->stepSimulation(total / static_cast<double>(steps));
+
+    std::vector<Vector2> positions;
+    for (const Object* object : *univ)
+        positions.push_back(object->getPosition());
+    return positions;
+}
+
+/**
+ * Returns the largest distance between matching positions
+ */
+double largestError(const std::vector<Vector2>& test, const std::vector<Vector2>& correct)
+{
+    double worst = 0.0;
+    for (std::size_t slot = 0; slot < test.size(); ++slot)
+        worst = std::max(worst, (test[slot] - correct[slot]).norm());
+    return worst;
+}
+
+} // anonymous namespace
+
+TEST_F(WisdomHolmanTest, KeplerDriftIsExact)
+{
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    const Object* sun = ObjectFactory::makeSun();
+    const double mu = Universe::G * sun->getMass();
+    const double perihelion = 1e11;
+    const double semiMajor = 5.5e11;
+    const double speed = std::sqrt(mu * (2.0 / perihelion - 1.0 / semiMajor));
+    const Object* planet = ObjectFactory::makePlanet(
+        "planet", 1e22, makeVector2(perihelion, 0), makeVector2(0, speed));
+    const double period
+        = 2.0 * std::numbers::pi * std::sqrt(semiMajor * semiMajor * semiMajor / mu);
+
+    // Without perturbers ten steps per orbit of eccentricity 0.82 are exact
+    univ->setIntegrator(std::make_unique<WisdomHolmanIntegrator>());
+    for (int i = 0; i < 30; ++i)
+        univ->stepSimulation(period / 10);
+    assertVector(planet->getPosition(), makeVector2(perihelion, 0), 10.0);
+    assertVector(planet->getVelocity(), makeVector2(0, speed), 1e-6);
+
+    // Halfway round it sits at aphelion, moving the other way
+    univ->stepSimulation(period / 2);
+    const double aphelion = 2 * semiMajor - perihelion;
+    assertVector(planet->getPosition(), makeVector2(-aphelion, 0), 10.0);
+    assertVector(planet->getVelocity(), makeVector2(0, -speed * perihelion / aphelion), 1e-6);
+}
+
+TEST_F(WisdomHolmanTest, UnboundOrbitsMatchIntegration)
+{
+    // Bound, nearly parabolic and hyperbolic orbits in one batch, more bodies than lanes
+    const double mu = 1.327e20;
+    const std::size_t count = 2 * KEPLER_LANES + 3;
+    std::vector<double> x(count);
+    std::vector<double> y(count);
+    std::vector<double> vx(count);
+    std::vector<double> vy(count);
+    BodyStore reference;
+    reference.add(mu / Universe::G, makeVector2(0, 0), makeVector2(0, 0));
+    for (std::size_t i = 0; i < count; ++i) {
+        const double radius = 1e11 * (1.0 + 0.1 * static_cast<double>(i));
+        const double escape = std::sqrt(2.0 * mu / radius);
+        const double angle = 0.3 * static_cast<double>(i);
+        x[i] = radius * std::cos(angle);
+        y[i] = radius * std::sin(angle);
+        // From 0.6 to 1.5 times the escape speed, partly radial
+        const double speed = escape * (0.6 + 0.05 * static_cast<double>(i));
+        vx[i] = speed * (0.3 * std::cos(angle) - std::sin(angle));
+        vy[i] = speed * (0.3 * std::sin(angle) + std::cos(angle));
+        reference.add(1.0, makeVector2(x[i], y[i]), makeVector2(vx[i], vy[i]));
+    }
+
+    const std::vector<double> startX = x;
+    const std::vector<double> startY = y;
+    const double dt = 3e7;
+    keplerDrift(mu, 0.0, 0.0, dt, 0, count, x.data(), y.data(), vx.data(), vy.data());
+    DormandPrinceIntegrator integrator(1e-13);
+    const std::unique_ptr<Universe> univ(Universe::instance());
+    integrator.step(reference, univ->getForceSolver(), dt);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vector2 position = reference.getPosition(i + 1);
+        assertVector(makeVector2(x[i], y[i]), position, 1e-8 * position.norm());
+    }
+
+    // And back again
+    keplerDrift(mu, 0.0, 0.0, -dt, 0, count, x.data(), y.data(), vx.data(), vy.data());
+    for (std::size_t i = 0; i < count; ++i)
+        assertVector(makeVector2(x[i], y[i]), makeVector2(startX[i], startY[i]), 1.0);
+}
+
+TEST_F(WisdomHolmanTest, DaysBeatHourlyLeapfrog)
+{
+    const std::vector<Vector2> reference
+        = runPlanets(std::make_unique<DormandPrinceIntegrator>(1e-13), 1e12);
+    const double leapfrog
+        = largestError(runPlanets(std::make_unique<LeapfrogIntegrator>(), 3600), reference);
+    const double wisdomHolman = largestError(
+        runPlanets(std::make_unique<WisdomHolmanIntegrator>(), 2 * 86400), reference);
+
+    // 48 times fewer force evaluations and still ten times more accurate
+    EXPECT_LT(wisdomHolman, leapfrog / 10);
+}
+
+TEST_F(WisdomHolmanTest, ParallelMatchesSerial)
+{
+    const std::vector<Vector2> serial
+        = runPlanets(std::make_unique<WisdomHolmanIntegrator>(), 10 * 86400, 1);
+    const std::vector<Vector2> parallel
+        = runPlanets(std::make_unique<WisdomHolmanIntegrator>(), 10 * 86400, 4);
+    // The solver sums in a different order in parallel, the drift is per body
+    for (std::size_t slot = 0; slot < serial.size(); ++slot)
+        assertVector(parallel[slot], serial[slot], 1.0);
+}